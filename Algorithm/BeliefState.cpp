@@ -0,0 +1,55 @@
+#include "BeliefState.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace Algorithm_208000547_208000547 {
+
+namespace {
+// Never act on a view older than this many rounds
+constexpr int MAX_ROUNDS_WITHOUT_INFO = 8;
+}
+
+void BeliefState::observe(const BoardPlanes& planes, BoardPlanes::Plane enemyPlane, int projectedRounds) {
+    width = static_cast<int>(planes.getColumns());
+    height = static_cast<int>(planes.getRows());
+    rounds = 1;
+    threatRounds = projectedRounds;
+    shellsSeen = planes.count(BoardPlanes::Shell) > 0;
+
+    enemies.clear();
+    planes.forEachCell(enemyPlane, [this](size_t x, size_t y) {
+        enemies.emplace_back(static_cast<int>(x), static_cast<int>(y));
+    });
+    threatMap.build(planes, projectedRounds);
+}
+
+int BeliefState::distance(int x1, int y1, int x2, int y2) const {
+    // A tank moves diagonally as fast as straight, so moves are the larger wrapped difference
+    const int dx = std::abs(x1 - x2);
+    const int dy = std::abs(y1 - y2);
+    return std::max(std::min(dx, width - dx), std::min(dy, height - dy));
+}
+
+double BeliefState::confidence(int x, int y) const {
+    if (!hasObserved() || rounds >= MAX_ROUNDS_WITHOUT_INFO) {
+        return 0.0;
+    }
+
+    // Seen shells are only accounted for while the threat map still projects them
+    if (shellsSeen && nextShellRound() > threatRounds) {
+        return 0.0;
+    }
+
+    // An enemy that has had `rounds` rounds to move may be up to that many cells away from where
+    // it was seen, which matters less the farther away it is. The first round is free since a
+    // view is always at least that old when acted on, and the margin of 2 lets a tank act at
+    // least once even next to an enemy.
+    double result = 1.0;
+    for (const auto& [enemyX, enemyY] : enemies) {
+        const int d = distance(x, y, enemyX, enemyY);
+        result = std::min(result, 1.0 - std::min(1.0, static_cast<double>(rounds - 1) / (d + 2)));
+    }
+    return result;
+}
+
+} // namespace Algorithm_208000547_208000547
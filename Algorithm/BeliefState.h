@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "../UserCommon/BoardPlanes.h"
+#include "ThreatMap.h"
+
+namespace Algorithm_208000547_208000547 {
+
+// What a tank believes about the board between two battle infos. The last satellite view is
+// dead-reckoned forward one round per turn: the tank tracks its own moves itself, shells follow
+// the threat map's projections, and each enemy may be anywhere within one cell per round of
+// where it was seen. confidence() turns that growing uncertainty into a number, so the tank can
+// ask for battle info when its picture has gone stale instead of on a fixed schedule.
+class BeliefState {
+public:
+    using BoardPlanes = UserCommon_208000547_208000547::BoardPlanes;
+
+    // A new satellite view, seen at the start of the current round
+    void observe(const BoardPlanes& planes, BoardPlanes::Plane enemyPlane, int threatRounds);
+
+    // One more turn has passed; call once per getAction()
+    void advance() {
+        if (rounds > 0) {
+            ++rounds;
+        }
+    }
+
+    bool hasObserved() const { return rounds > 0; }
+
+    // Rounds of movement since the board was seen, the current round included
+    int roundsSinceSnapshot() const { return rounds; }
+
+    // Threat map round of the next shell movement (an action taken now is in place by then)
+    int nextShellRound() const { return rounds + 1; }
+
+    const ThreatMap& threats() const { return threatMap; }
+
+    // How sure the tank at (x, y) can be that the believed board is still good enough to act
+    // on, from 0 (ask for battle info) to 1 (just seen). The least sure of: how far the nearest
+    // enemy may have moved relative to its distance, whether seen shells are still within the
+    // threat map's projection, and a hard limit on rounds without info.
+    double confidence(int x, int y) const;
+
+private:
+    int width = 0;
+    int height = 0;
+    int rounds = 0;  // 0 until the first observation
+    int threatRounds = 0;
+    bool shellsSeen = false;
+    std::vector<std::pair<int, int>> enemies;  // Last seen positions
+    ThreatMap threatMap;
+
+    int distance(int x1, int y1, int x2, int y2) const;  // Moves between two cells, with wrap
+};
+
+} // namespace Algorithm_208000547_208000547
@@ -0,0 +1,469 @@
+#include "HierarchicalPathFinder.h"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <tuple>
+#include <unordered_map>
+
+namespace Algorithm_208000547_208000547 {
+
+HierarchicalPathFinder::HierarchicalPathFinder(const vector<vector<char>>& board, int boardRows, int boardColumns,
+                                               size_t steps)
+    : rows(boardRows), columns(boardColumns),
+      clusterColumns((boardColumns + CLUSTER_SIZE - 1) / CLUSTER_SIZE),
+      clusterRows((boardRows + CLUSTER_SIZE - 1) / CLUSTER_SIZE),
+      refineSteps(steps) {
+    open.resize(static_cast<size_t>(rows) * columns);
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < columns; ++x) {
+            open[y * columns + x] = isOpen(board[y][x]);
+        }
+    }
+    const int clusterCount = clusterColumns * clusterRows;
+    parts.assign(open.size(), NO_PART);
+    borders.assign(static_cast<size_t>(clusterCount) * BorderCount, {});
+    clusters.assign(clusterCount, {});
+    for (int c = 0; c < clusterCount; ++c) {
+        labelCluster(c);
+    }
+    for (int c = 0; c < clusterCount; ++c) {
+        buildBorders(c);
+    }
+    for (int c = 0; c < clusterCount; ++c) {
+        buildCluster(c);
+    }
+}
+
+bool HierarchicalPathFinder::isOpen(char cell) {
+    // Every tank is open ground, the one drawn as REQUESTING_TANK included: it is somebody's start
+    return cell == EMPTY_SPACE || cell == PLAYER1_TANK || cell == PLAYER2_TANK || cell == REQUESTING_TANK;
+}
+
+int HierarchicalPathFinder::clusterOf(int cell) const {
+    return (cell / columns / CLUSTER_SIZE) * clusterColumns + (cell % columns) / CLUSTER_SIZE;
+}
+
+int HierarchicalPathFinder::clusterAt(int cx, int cy) const {
+    return ((cy + clusterRows) % clusterRows) * clusterColumns + (cx + clusterColumns) % clusterColumns;
+}
+
+void HierarchicalPathFinder::bounds(int cluster, int& x0, int& y0, int& x1, int& y1) const {
+    x0 = (cluster % clusterColumns) * CLUSTER_SIZE;
+    y0 = (cluster / clusterColumns) * CLUSTER_SIZE;
+    x1 = std::min(columns, x0 + CLUSTER_SIZE);
+    y1 = std::min(rows, y0 + CLUSTER_SIZE);
+}
+
+void HierarchicalPathFinder::makePatch(int cluster, Patch& patch) const {
+    int x0, y0, x1, y1;
+    bounds(cluster, x0, y0, x1, y1);
+    patch.x0 = x0;
+    patch.y0 = y0;
+    patch.stride = x1 - x0 + 2;
+    for (int i = 0; i < 8; ++i) {
+        const Direction dir = Direction(Direction::Up).rotated(i);
+        patch.offsets[i] = dir.dy() * patch.stride + dir.dx();
+    }
+    patch.open.assign(static_cast<size_t>(patch.stride) * (y1 - y0 + 2), 0);
+    for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; ++x) {
+            patch.open[(y - y0 + 1) * patch.stride + x - x0 + 1] = open[y * columns + x];
+        }
+    }
+}
+
+void HierarchicalPathFinder::searchPatch(Patch& patch, int from, vector<int>& distance, vector<int>* parent) const {
+    distance.assign(patch.open.size(), -1);
+    if (parent) {
+        parent->assign(patch.open.size(), -1);
+    }
+    const int first = patch.index(from, columns);
+    distance[first] = 0;
+    patch.queue.assign(1, first);
+    for (size_t head = 0; head < patch.queue.size(); ++head) {
+        const int at = patch.queue[head];
+        for (int offset : patch.offsets) {
+            const int next = at + offset;
+            if (patch.open[next] && distance[next] < 0) {
+                distance[next] = distance[at] + 1;
+                if (parent) {
+                    (*parent)[next] = at;
+                }
+                patch.queue.push_back(next);
+            }
+        }
+    }
+}
+
+void HierarchicalPathFinder::labelCluster(int cluster) {
+    Patch patch;
+    makePatch(cluster, patch);
+    vector<uint8_t> label(patch.open.size(), NO_PART);
+    uint8_t count = 0;
+    for (size_t first = 0; first < patch.open.size(); ++first) {
+        if (!patch.open[first] || label[first] != NO_PART) {
+            continue;
+        }
+        label[first] = count;
+        patch.queue.assign(1, static_cast<int>(first));
+        for (size_t head = 0; head < patch.queue.size(); ++head) {
+            for (int offset : patch.offsets) {
+                const int next = patch.queue[head] + offset;
+                if (patch.open[next] && label[next] == NO_PART) {
+                    label[next] = count;
+                    patch.queue.push_back(next);
+                }
+            }
+        }
+        ++count;
+    }
+
+    int x0, y0, x1, y1;
+    bounds(cluster, x0, y0, x1, y1);
+    for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; ++x) {
+            parts[y * columns + x] = label[patch.index(y * columns + x, columns)];
+        }
+    }
+}
+
+void HierarchicalPathFinder::crossLine(const vector<int>& sideA, const vector<int>& sideB, vector<Transition>& out) const {
+    const int length = static_cast<int>(sideA.size());
+
+    // Moves across the border from side A cell i to side B cells i-1, i and i+1
+    auto crosses = [&](int i, int j) {
+        return j >= 0 && j < length && sideA[i] != sideB[j] && open[sideA[i]] && open[sideB[j]];
+    };
+    auto crossable = [&](int i) { return crosses(i, i - 1) || crosses(i, i) || crosses(i, i + 1); };
+
+    struct Candidate {
+        int partA;
+        int partB;
+        int score;  // Lower is closer to the middle of its stretch, straight across preferred
+        Transition transition;
+    };
+    vector<Candidate> candidates;
+    for (int i = 0; i < length;) {
+        if (!crossable(i)) {
+            ++i;
+            continue;
+        }
+        int end = i;
+        while (end < length && end - i < ENTRANCE_WIDTH && crossable(end)) {
+            ++end;
+        }
+
+        // One entrance per pair of connected parts the stretch joins, as near its middle as possible
+        candidates.clear();
+        for (int a = i; a < end; ++a) {
+            for (int b = a - 1; b <= a + 1; ++b) {
+                if (!crosses(a, b)) {
+                    continue;
+                }
+                const int score = std::abs(2 * a - (i + end - 1)) * 2 + (a != b);
+                const Candidate candidate = {parts[sideA[a]], parts[sideB[b]], score, {sideA[a], sideB[b]}};
+                auto same = std::find_if(candidates.begin(), candidates.end(), [&](const Candidate& c) {
+                    return c.partA == candidate.partA && c.partB == candidate.partB;
+                });
+                if (same == candidates.end()) {
+                    candidates.push_back(candidate);
+                } else if (candidate.score < same->score) {
+                    *same = candidate;
+                }
+            }
+        }
+        for (const Candidate& candidate : candidates) {
+            out.push_back(candidate.transition);
+        }
+        i = end;
+    }
+}
+
+void HierarchicalPathFinder::buildBorders(int cluster) {
+    int x0, y0, x1, y1;
+    bounds(cluster, x0, y0, x1, y1);
+    vector<Transition>* owned = &borders[static_cast<size_t>(cluster) * BorderCount];
+    vector<int> sideA;
+    vector<int> sideB;
+
+    owned[East].clear();
+    for (int y = y0; y < y1; ++y) {
+        sideA.push_back(cellAt(x1 - 1, y));
+        sideB.push_back(cellAt(x1, y));
+    }
+    crossLine(sideA, sideB, owned[East]);
+
+    owned[South].clear();
+    sideA.clear();
+    sideB.clear();
+    for (int x = x0; x < x1; ++x) {
+        sideA.push_back(cellAt(x, y1 - 1));
+        sideB.push_back(cellAt(x, y1));
+    }
+    crossLine(sideA, sideB, owned[South]);
+
+    auto corner = [&](vector<Transition>& out, int a, int b) {
+        out.clear();
+        if (a != b && open[a] && open[b]) {
+            out.push_back({a, b});
+        }
+    };
+    corner(owned[SouthEast], cellAt(x1 - 1, y1 - 1), cellAt(x1, y1));
+    corner(owned[SouthWest], cellAt(x0, y1 - 1), cellAt(x0 - 1, y1));
+}
+
+void HierarchicalPathFinder::buildCluster(int cluster) {
+    const int cx = cluster % clusterColumns;
+    const int cy = cluster / clusterColumns;
+
+    // The cluster's own borders and the ones its west, north, north-west and north-east
+    // neighbours own towards it; on narrow boards some of these are the same
+    size_t records[] = {
+        static_cast<size_t>(cluster) * BorderCount + East,
+        static_cast<size_t>(cluster) * BorderCount + South,
+        static_cast<size_t>(cluster) * BorderCount + SouthEast,
+        static_cast<size_t>(cluster) * BorderCount + SouthWest,
+        static_cast<size_t>(clusterAt(cx - 1, cy)) * BorderCount + East,
+        static_cast<size_t>(clusterAt(cx, cy - 1)) * BorderCount + South,
+        static_cast<size_t>(clusterAt(cx - 1, cy - 1)) * BorderCount + SouthEast,
+        static_cast<size_t>(clusterAt(cx + 1, cy - 1)) * BorderCount + SouthWest,
+    };
+    std::sort(std::begin(records), std::end(records));
+    const size_t* recordsEnd = std::unique(std::begin(records), std::end(records));
+
+    Cluster& c = clusters[cluster];
+    c = Cluster{};
+    auto addNode = [&](int cell, int partner) {
+        const auto at = std::find(c.nodes.begin(), c.nodes.end(), cell);
+        if (at == c.nodes.end()) {
+            c.nodes.push_back(cell);
+            c.partners.emplace_back(1, partner);
+        } else {
+            c.partners[at - c.nodes.begin()].push_back(partner);
+        }
+    };
+    for (const size_t* r = records; r != recordsEnd; ++r) {
+        for (const Transition& t : borders[*r]) {
+            if (clusterOf(t.a) == cluster) {
+                addNode(t.a, t.b);
+            }
+            if (clusterOf(t.b) == cluster) {
+                addNode(t.b, t.a);
+            }
+        }
+    }
+
+    const size_t count = c.nodes.size();
+    c.distances.assign(count * count, -1);
+    Patch patch;
+    makePatch(cluster, patch);
+    vector<int> distance;
+    for (size_t i = 0; i < count; ++i) {
+        searchPatch(patch, c.nodes[i], distance, nullptr);
+        for (size_t j = 0; j < count; ++j) {
+            c.distances[i * count + j] = distance[patch.index(c.nodes[j], columns)];
+        }
+    }
+}
+
+void HierarchicalPathFinder::update(const vector<vector<char>>& board) {
+    if (static_cast<int>(board.size()) != rows || (rows > 0 && static_cast<int>(board[0].size()) != columns)) {
+        return;  // Not a view of this map
+    }
+    vector<int> changed;
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < columns; ++x) {
+            const int cell = y * columns + x;
+            if (open[cell] != isOpen(board[y][x])) {
+                open[cell] = !open[cell];
+                changed.push_back(clusterOf(cell));
+            }
+        }
+    }
+    if (changed.empty()) {
+        return;
+    }
+    std::sort(changed.begin(), changed.end());
+    changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+
+    // A cluster's entrances sit on its own borders and on those its west, north, north-west and
+    // north-east neighbours own; the entrances of all 8 neighbours may move with them
+    vector<bool> bordersToBuild(clusters.size(), false);
+    vector<bool> clustersToBuild(clusters.size(), false);
+    for (int cluster : changed) {
+        labelCluster(cluster);
+        const int cx = cluster % clusterColumns;
+        const int cy = cluster / clusterColumns;
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                clustersToBuild[clusterAt(cx + dx, cy + dy)] = true;
+            }
+        }
+        for (int owner : {cluster, clusterAt(cx - 1, cy), clusterAt(cx, cy - 1), clusterAt(cx - 1, cy - 1), clusterAt(cx + 1, cy - 1)}) {
+            bordersToBuild[owner] = true;
+        }
+    }
+    for (size_t c = 0; c < clusters.size(); ++c) {
+        if (bordersToBuild[c]) {
+            buildBorders(static_cast<int>(c));
+        }
+    }
+    for (size_t c = 0; c < clusters.size(); ++c) {
+        if (clustersToBuild[c]) {
+            buildCluster(static_cast<int>(c));
+        }
+    }
+}
+
+vector<int> HierarchicalPathFinder::searchAbstract(int start, int end, size_t& expanded) const {
+    const int startCluster = clusterOf(start);
+    const int endCluster = clusterOf(end);
+    Patch startPatch;
+    Patch endPatch;
+    vector<int> fromStart;
+    vector<int> toEnd;
+    makePatch(startCluster, startPatch);
+    makePatch(endCluster, endPatch);
+    searchPatch(startPatch, start, fromStart, nullptr);
+    searchPatch(endPatch, end, toEnd, nullptr);
+
+    // A* over the entrance cells, with the start and end joined to the entrances of their clusters
+    const Point target = {end % columns, end / columns};
+    auto heuristic = [&](int cell) { return dist({cell % columns, cell / columns}, target, columns, rows); };  // dist takes the x extent first
+    std::unordered_map<int, int> cost;
+    std::unordered_map<int, int> parent;
+    using Entry = std::tuple<int, int, int>;  // (f, g, cell)
+    std::priority_queue<Entry, vector<Entry>, std::greater<Entry>> frontier;
+    auto relax = [&](int from, int cell, int g) {
+        const auto it = cost.find(cell);
+        if (it == cost.end() || g < it->second) {
+            cost[cell] = g;
+            parent[cell] = from;
+            frontier.emplace(g + heuristic(cell), g, cell);
+        }
+    };
+    cost[start] = 0;
+    parent[start] = -1;
+    frontier.emplace(heuristic(start), 0, start);
+
+    while (!frontier.empty()) {
+        const auto [f, g, cell] = frontier.top();
+        frontier.pop();
+        if (g != cost[cell]) {
+            continue;  // Reached more cheaply after this entry was queued
+        }
+        ++expanded;
+        if (cell == end) {
+            vector<int> waypoints;
+            for (int at = end; at != -1; at = parent[at]) {
+                waypoints.push_back(at);
+            }
+            std::reverse(waypoints.begin(), waypoints.end());
+            return waypoints;
+        }
+
+        if (cell == start) {
+            for (int node : clusters[startCluster].nodes) {
+                const int d = fromStart[startPatch.index(node, columns)];
+                if (d > 0) {
+                    relax(cell, node, g + d);
+                }
+            }
+            if (startCluster == endCluster && fromStart[startPatch.index(end, columns)] > 0) {
+                relax(cell, end, g + fromStart[startPatch.index(end, columns)]);
+            }
+        }
+        const int cluster = clusterOf(cell);
+        const Cluster& c = clusters[cluster];
+        const auto at = std::find(c.nodes.begin(), c.nodes.end(), cell);
+        if (at == c.nodes.end()) {
+            continue;  // The start, when it is no entrance
+        }
+        const size_t i = at - c.nodes.begin();
+        for (size_t j = 0; j < c.nodes.size(); ++j) {
+            const int d = c.distances[i * c.nodes.size() + j];
+            if (d > 0) {
+                relax(cell, c.nodes[j], g + d);
+            }
+        }
+        for (int partner : c.partners[i]) {
+            relax(cell, partner, g + 1);
+        }
+        if (cluster == endCluster && toEnd[endPatch.index(cell, columns)] > 0) {
+            relax(cell, end, g + toEnd[endPatch.index(cell, columns)]);
+        }
+    }
+    return {};
+}
+
+vector<Point> HierarchicalPathFinder::refine(const vector<int>& waypoints) const {
+    auto toPoint = [&](int cell) { return Point{cell % columns, cell / columns}; };
+    vector<Point> path = {toPoint(waypoints[0])};
+    Patch patch;
+    vector<int> distance;
+    vector<int> parent;
+    vector<int> segment;
+    for (size_t i = 1; i < waypoints.size(); ++i) {
+        const int from = waypoints[i - 1];
+        const int to = waypoints[i];
+        if (path.size() > refineSteps || dist(toPoint(from), toPoint(to), columns, rows) == 1) {
+            path.push_back(toPoint(to));  // A single move, or past the part planned move by move
+            continue;
+        }
+
+        // Any other hop runs inside one cluster
+        makePatch(clusterOf(from), patch);
+        searchPatch(patch, from, distance, &parent);
+        segment.clear();
+        for (int at = patch.index(to, columns); at != -1 && parent[at] != -1; at = parent[at]) {
+            segment.push_back(patch.cell(at, columns));
+        }
+        if (segment.empty()) {
+            path.push_back(toPoint(to));
+            continue;
+        }
+        for (auto it = segment.rbegin(); it != segment.rend(); ++it) {
+            path.push_back(toPoint(*it));
+        }
+    }
+    return path;
+}
+
+void HierarchicalPathFinder::findPath(const vector<vector<char>>& grid, Point start, Point end, bool includeWalls,
+                                      SearchContext& context, vector<Point>& path) const {
+    if (includeWalls || static_cast<int>(grid.size()) != rows || (rows > 0 && static_cast<int>(grid[0].size()) != columns)) {
+        ::findPath(grid, start, end, includeWalls, context, path);
+        return;
+    }
+    path.clear();
+    if (start.x < 0 || start.x >= columns || start.y < 0 || start.y >= rows ||
+        end.x < 0 || end.x >= columns || end.y < 0 || end.y >= rows) {
+        return;
+    }
+    if (start == end) {
+        path.push_back(start);
+        return;
+    }
+    const int endCell = end.y * columns + end.x;
+    size_t expanded = 0;
+    const vector<int> waypoints = open[endCell] ? searchAbstract(start.y * columns + start.x, endCell, expanded) : vector<int>();
+    if (waypoints.empty()) {
+        ::findPath(grid, start, end, true, context, path);  // Like bfsPathfinder, through walls if there is no other way
+        return;
+    }
+    path = refine(waypoints);
+    std::cout << "HPA*: path length " << pathLength(path, columns, rows) + 1 << ", " << waypoints.size()
+              << " waypoints, expanded " << expanded << " entrances" << std::endl;
+}
+
+size_t HierarchicalPathFinder::entranceCount() const {
+    size_t count = 0;
+    for (const Cluster& c : clusters) {
+        count += c.nodes.size();
+    }
+    return count;
+}
+
+} // namespace Algorithm_208000547_208000547
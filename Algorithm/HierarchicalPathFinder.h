@@ -0,0 +1,112 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "PathFinder.h"
+
+namespace Algorithm_208000547_208000547 {
+
+// HPA*-style path search for big maps, built by the Player from its first satellite view and
+// shared by all of its tanks:
+//  - The board is cut into CLUSTER_SIZE x CLUSTER_SIZE clusters. Where open cells meet across a
+//    cluster border (corners and wrap-around included), a pair of entrance cells is kept for each
+//    stretch of up to ENTRANCE_WIDTH border cells and each pair of connected parts of the two
+//    clusters it joins. Inside each cluster the move distances between its entrance cells are
+//    kept.
+//  - A search runs over the entrance cells only, with the start and end hooked in by a search of
+//    their own clusters. Only the first refineSteps moves of the result are filled in cell by
+//    cell; after that the path lists the remaining entrance cells, and a tank that gets there
+//    plans again (see OffensiveTankAlgorithm::followPath).
+//  - update() rebuilds only the clusters around cells that opened or closed, so a fallen wall or
+//    a passing shell costs a few clusters.
+// Cells are open as in bfsPathfinder without walls. Searches through walls go to the flat
+// findPath(): with walls open only mines and shells are left to steer around, and its heuristic
+// already keeps it close to the path. Paths are shortest over the entrance cells, usually a few
+// moves longer than the shortest on the board.
+class HierarchicalPathFinder {
+public:
+    static constexpr int CLUSTER_SIZE = 16;
+    static constexpr int ENTRANCE_WIDTH = 8;
+    static constexpr size_t MIN_CELLS = size_t{1} << 16;  // Smaller boards are searched directly
+
+    HierarchicalPathFinder(const vector<vector<char>>& board, int rows, int columns, size_t refineSteps = 32);
+
+    int getRows() const { return rows; }
+    int getColumns() const { return columns; }
+
+    // Rebuild the clusters whose cells opened or closed on `board` (a later view of the same map)
+    void update(const vector<vector<char>>& board);
+
+    // Same contract as the context form of bfsPathfinder, answered on the board last given to
+    // update(); `grid` must be a view of that board. The flat searches it falls back to run on
+    // `context`. Steps after the first refineSteps may be more than one move apart: measure the
+    // path with pathLength().
+    void findPath(const vector<vector<char>>& grid, Point start, Point end, bool includeWalls,
+                  SearchContext& context, vector<Point>& path) const;
+
+    size_t entranceCount() const;
+
+private:
+    // Border kinds each cluster owns, towards its east, south, south-east and south-west neighbours
+    enum Border { East, South, SouthEast, SouthWest, BorderCount };
+
+    struct Transition {
+        int a;  // Cell in the owning cluster
+        int b;  // Cell one move away, across the border
+    };
+
+    struct Cluster {
+        vector<int> nodes;               // Entrance cells
+        vector<vector<int>> partners;    // Per node, the cells one move away across a border
+        vector<int> distances;           // nodes x nodes; -1 if not connected inside the cluster
+    };
+
+    // One cluster's open cells inside a ring of closed ones, for searches that stay in the cluster
+    // without checking its bounds; indices are into `open`
+    struct Patch {
+        int x0 = 0;
+        int y0 = 0;
+        int stride = 0;  // Cluster width + 2
+        int offsets[8] = {};
+        vector<uint8_t> open;
+        vector<int> queue;
+
+        int index(int cell, int columns) const { return (cell / columns - y0 + 1) * stride + cell % columns - x0 + 1; }
+        int cell(int index, int columns) const { return (y0 + index / stride - 1) * columns + x0 + index % stride - 1; }
+    };
+
+    // 8-connected parts of a 16 x 16 cluster are at least two cells apart, so at most 64 of them
+    static constexpr uint8_t NO_PART = 0xFF;
+
+    int rows;
+    int columns;
+    int clusterColumns;
+    int clusterRows;
+    size_t refineSteps;
+    vector<bool> open;                   // Per cell
+    vector<uint8_t> parts;               // Per cell, its connected part within its cluster
+    vector<vector<Transition>> borders;  // cluster * BorderCount + Border
+    vector<Cluster> clusters;
+
+    static bool isOpen(char cell);
+    int cellAt(int x, int y) const { return ((y + rows) % rows) * columns + (x + columns) % columns; }
+    int clusterOf(int cell) const;
+    int clusterAt(int cx, int cy) const;
+    void bounds(int cluster, int& x0, int& y0, int& x1, int& y1) const;  // x1, y1 exclusive
+
+    void makePatch(int cluster, Patch& patch) const;
+    // Breadth-first search from `from` within the patch's cluster; distance (and parent) per patch
+    // index, -1 if not reached. `from` itself may hold anything.
+    void searchPatch(Patch& patch, int from, vector<int>& distance, vector<int>* parent) const;
+
+    void labelCluster(int cluster);
+    void buildBorders(int cluster);
+    void crossLine(const vector<int>& sideA, const vector<int>& sideB, vector<Transition>& out) const;
+    void buildCluster(int cluster);
+
+    vector<int> searchAbstract(int start, int end, size_t& expanded) const;
+    vector<Point> refine(const vector<int>& waypoints) const;
+};
+
+} // namespace Algorithm_208000547_208000547
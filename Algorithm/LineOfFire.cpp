@@ -0,0 +1,38 @@
+#include "LineOfFire.h"
+#include <cstdint>
+#include <numeric>
+
+namespace Algorithm_208000547_208000547 {
+
+int LineOfFire::cycleLength(Direction dir, int width, int height) {
+    if (dir.dy() == 0) {
+        return width;
+    }
+    if (dir.dx() == 0) {
+        return height;
+    }
+    return std::lcm(width, height);
+}
+
+int LineOfFire::shotsAt(const BoardPlanes& planes, BoardPlanes::PlaneMask targets, int x, int y, Shot (&out)[8]) {
+    const int width = static_cast<int>(planes.getColumns());
+    const int height = static_cast<int>(planes.getRows());
+    int count = 0;
+    for (int d = 0; d < 8; ++d) {
+        const Direction dir = Direction::fromIndex(d);
+        const size_t steps = planes.firstHit(STOPPING, static_cast<size_t>(x), static_cast<size_t>(y), dir,
+                                             static_cast<size_t>(cycleLength(dir, width, height)));
+        if (steps == 0) {
+            continue;
+        }
+        const int64_t reach = static_cast<int64_t>(steps);
+        const size_t targetX = static_cast<size_t>(((x + dir.dx() * reach) % width + width) % width);
+        const size_t targetY = static_cast<size_t>(((y + dir.dy() * reach) % height + height) % height);
+        if (planes.test(targets, targetX, targetY)) {
+            out[count++] = {dir, static_cast<int>(steps)};
+        }
+    }
+    return count;
+}
+
+} // namespace Algorithm_208000547_208000547
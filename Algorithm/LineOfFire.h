@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+
+#include "../UserCommon/BoardPlanes.h"
+#include "../UserCommon/Direction.h"
+
+namespace Algorithm_208000547_208000547 {
+
+// Lines of fire on a wrap-around board: what a shell fired from a cell in each of the 8
+// directions reaches first, scanned straight from a BoardPlanes when asked.
+class LineOfFire {
+public:
+    using Direction = UserCommon_208000547_208000547::Direction;
+    using BoardPlanes = UserCommon_208000547_208000547::BoardPlanes;
+
+    // Objects that stop a shell
+    static constexpr BoardPlanes::PlaneMask STOPPING = BoardPlanes::BLOCKING | BoardPlanes::TANKS;
+
+    struct Shot {
+        Direction direction;
+        int steps;  // Cells the shell travels, the hit cell included
+    };
+
+    // Directions from (x, y) whose first stopping object is in any of `targets`, written to `out`
+    // in direction order; returns how many there are
+    static int shotsAt(const BoardPlanes& planes, BoardPlanes::PlaneMask targets, int x, int y, Shot (&out)[8]);
+
+private:
+    static int cycleLength(Direction dir, int width, int height);  // Steps until a ray returns to its start cell
+};
+
+} // namespace Algorithm_208000547_208000547
@@ -0,0 +1,371 @@
+#include "MapAnalysis.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace Algorithm_208000547_208000547 {
+
+namespace {
+constexpr int UNLABELLED = -2;
+
+// Landmark tables hold at most this many entries in total, and there are at most this many
+// landmarks
+constexpr size_t LANDMARK_TABLE_BUDGET = size_t{1} << 22;
+constexpr size_t MAX_LANDMARKS = 16;
+
+bool isObstacle(char cell) {
+    return cell == WALL || cell == DAMAGED_WALL || cell == MINE ||
+           cell == WALL_SHELL_COLLISION || cell == MINE_SHELL_COLLISION;
+}
+
+bool isTank(char cell) {
+    return cell == PLAYER1_TANK || cell == PLAYER2_TANK || cell == REQUESTING_TANK;
+}
+}
+
+MapAnalysis::MapAnalysis(const vector<vector<char>>& board, int boardRows, int boardColumns, TaskScheduler* scheduler)
+    : rows(boardRows), columns(boardColumns) {
+    const size_t cells = cellCount();
+    regionOf.assign(cells, UNLABELLED);
+    obstacleIndex.assign(cells, -1);
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < columns; ++x) {
+            if (isObstacle(board[y][x])) {
+                regionOf[index(x, y)] = NO_REGION;
+                obstacleIndex[index(x, y)] = static_cast<int>(obstacles.size());
+                obstacles.push_back(index(x, y));
+            }
+        }
+    }
+
+    findRegions();
+    findChokePoints();
+    placeLandmarks(board, scheduler);
+    findBreachCandidates(board);
+
+    opened.assign(obstacles.size(), false);
+    unionParent.resize(regions + obstacles.size());
+    unionSize.assign(unionParent.size(), 1);
+    for (size_t i = 0; i < unionParent.size(); ++i) {
+        unionParent[i] = static_cast<int>(i);
+    }
+}
+
+int MapAnalysis::neighbours(size_t cell, size_t (&out)[8]) const {
+    const int x = static_cast<int>(cell % columns);
+    const int y = static_cast<int>(cell / columns);
+    int count = 0;
+    for (int d = 0; d < 8; ++d) {
+        const Direction dir = Direction::fromIndex(d);
+        const size_t next = index((x + dir.dx() + columns) % columns, (y + dir.dy() + rows) % rows);
+        // On boards 1 or 2 cells wide, several moves lead to the same cell
+        if (next != cell && std::find(out, out + count, next) == out + count) {
+            out[count++] = next;
+        }
+    }
+    return count;
+}
+
+void MapAnalysis::findRegions() {
+    vector<size_t> queue;
+    size_t near[8];
+    for (size_t start = 0; start < cellCount(); ++start) {
+        if (regionOf[start] != UNLABELLED) {
+            continue;
+        }
+        regionOf[start] = regions;
+        queue.assign(1, start);
+        for (size_t head = 0; head < queue.size(); ++head) {
+            const int count = neighbours(queue[head], near);
+            for (int i = 0; i < count; ++i) {
+                if (regionOf[near[i]] == UNLABELLED) {
+                    regionOf[near[i]] = regions;
+                    queue.push_back(near[i]);
+                }
+            }
+        }
+        ++regions;
+    }
+}
+
+void MapAnalysis::findChokePoints() {
+    // Articulation points by Tarjan's algorithm, with an explicit stack so that big open maps
+    // cannot overflow the call stack. The stack can hold a frame per open cell, so a frame keeps
+    // only its cell and how many neighbours it has visited. The top frame's neighbours are
+    // recomputed whenever a frame becomes the top one
+    struct Frame {
+        size_t cell;
+        int next;
+    };
+    const size_t cells = cellCount();
+    const size_t none = cells;
+    vector<int> discovered(cells, -1);
+    vector<int> low(cells, 0);
+    vector<size_t> parent(cells, none);
+    chokeFlags.assign(cells, false);
+    vector<Frame> stack;
+    size_t near[8];  // Neighbours of the top frame's cell
+    int nearCount = 0;
+    int time = 0;
+
+    for (size_t root = 0; root < cells; ++root) {
+        if (!isOpen(root) || discovered[root] >= 0) {
+            continue;
+        }
+        int rootChildren = 0;
+        discovered[root] = low[root] = time++;
+        stack.push_back({root, 0});
+        nearCount = neighbours(root, near);
+
+        while (!stack.empty()) {
+            Frame& frame = stack.back();
+            if (frame.next < nearCount) {
+                const size_t u = frame.cell;
+                const size_t v = near[frame.next++];
+                if (!isOpen(v)) {
+                    continue;
+                }
+                if (discovered[v] < 0) {
+                    parent[v] = u;
+                    discovered[v] = low[v] = time++;
+                    if (u == root) {
+                        ++rootChildren;
+                    }
+                    stack.push_back({v, 0});  // Invalidates `frame`
+                    nearCount = neighbours(v, near);
+                } else if (v != parent[u]) {
+                    low[u] = std::min(low[u], discovered[v]);
+                }
+                continue;
+            }
+
+            const size_t u = frame.cell;
+            stack.pop_back();
+            if (!stack.empty()) {
+                const size_t p = stack.back().cell;
+                nearCount = neighbours(p, near);
+                low[p] = std::min(low[p], low[u]);
+                if (p != root && low[u] >= discovered[p]) {
+                    chokeFlags[p] = true;
+                }
+            }
+        }
+        if (rootChildren >= 2) {
+            chokeFlags[root] = true;
+        }
+    }
+
+    for (size_t cell = 0; cell < cells; ++cell) {
+        if (chokeFlags[cell]) {
+            chokes.push_back({static_cast<int>(cell % columns), static_cast<int>(cell / columns)});
+        }
+    }
+}
+
+void MapAnalysis::distancesFrom(size_t start, uint16_t* out) const {
+    std::fill(out, out + cellCount(), UNREACHABLE);
+    if (!isOpen(start)) {
+        return;
+    }
+    vector<size_t> queue(1, start);
+    out[start] = 0;
+    size_t near[8];
+    for (size_t head = 0; head < queue.size(); ++head) {
+        const size_t cell = queue[head];
+        const uint16_t next = out[cell] < UNREACHABLE - 1 ? static_cast<uint16_t>(out[cell] + 1) : out[cell];
+        const int count = neighbours(cell, near);
+        for (int i = 0; i < count; ++i) {
+            if (isOpen(near[i]) && out[near[i]] == UNREACHABLE) {
+                out[near[i]] = next;
+                queue.push_back(near[i]);
+            }
+        }
+    }
+}
+
+void MapAnalysis::distancesFrom(size_t first, const FieldBatch& batch, TaskScheduler* scheduler) {
+    const size_t cells = cellCount();
+    const vector<Point> sources(landmarks.begin() + first, landmarks.end());
+    vector<int> fields;
+    batch.distances(sources, fields, scheduler);
+    for (size_t i = 0; i < sources.size(); ++i) {
+        uint16_t* out = &landmarkDistances[(first + i) * cells];
+        if (!isOpen(index(sources[i].x, sources[i].y))) {
+            std::fill(out, out + cells, UNREACHABLE);
+            continue;
+        }
+        const int* field = &fields[i * cells];
+        for (size_t cell = 0; cell < cells; ++cell) {
+            out[cell] = field[cell] < 0 ? UNREACHABLE : static_cast<uint16_t>(std::min(field[cell], UNREACHABLE - 1));
+        }
+    }
+}
+
+void MapAnalysis::placeLandmarks(const vector<vector<char>>& board, TaskScheduler* scheduler) {
+    const size_t cells = cellCount();
+    if (cells == 0) {
+        return;
+    }
+    const size_t limit = std::min(MAX_LANDMARKS, std::max<size_t>(1, LANDMARK_TABLE_BUDGET / cells));
+    landmarkDistances.reserve(limit * cells);
+
+    // Big maps fill the tables a word of cells at a time
+    const bool wavefront = chooseFieldStrategy(rows, columns) == FieldStrategy::Wavefront;
+    FieldBatch batch(wavefront ? rows : 0, wavefront ? columns : 0);
+    if (wavefront) {
+        for (size_t cell = 0; cell < cells; ++cell) {
+            batch.setOpen(static_cast<int>(cell % columns), static_cast<int>(cell / columns), isOpen(cell));
+        }
+    }
+
+    auto addLandmarks = [&](const vector<size_t>& starts, TaskScheduler* threads) {
+        const size_t first = landmarks.size();
+        for (size_t cell : starts) {
+            landmarks.push_back({static_cast<int>(cell % columns), static_cast<int>(cell / columns)});
+        }
+        landmarkDistances.resize(landmarks.size() * cells);
+        if (wavefront) {
+            distancesFrom(first, batch, threads);
+            return;
+        }
+        for (size_t i = 0; i < starts.size(); ++i) {
+            distancesFrom(starts[i], &landmarkDistances[(first + i) * cells]);
+        }
+    };
+
+    // The tanks' starting cells are where distances are asked for most; their tables are
+    // independent, so they are filled together
+    vector<size_t> tanks;
+    for (int y = 0; y < rows && tanks.size() < limit; ++y) {
+        for (int x = 0; x < columns && tanks.size() < limit; ++x) {
+            if (isTank(board[y][x])) {
+                tanks.push_back(index(x, y));
+            }
+        }
+    }
+    addLandmarks(tanks, scheduler);
+
+    // Then the open cell farthest from all landmarks so far (unreachable counts as farthest)
+    while (landmarks.size() < limit) {
+        size_t best = cells;
+        uint32_t bestDistance = 0;
+        for (size_t cell = 0; cell < cells; ++cell) {
+            if (!isOpen(cell)) {
+                continue;
+            }
+            uint32_t nearest = UNREACHABLE + 1u;
+            for (size_t l = 0; l < landmarks.size(); ++l) {
+                nearest = std::min<uint32_t>(nearest, landmarkDistances[l * cells + cell]);
+            }
+            if (nearest > bestDistance) {
+                bestDistance = nearest;
+                best = cell;
+            }
+        }
+        if (best == cells) {
+            break;  // Every open cell is a landmark already
+        }
+        addLandmarks({best}, nullptr);
+    }
+}
+
+void MapAnalysis::findBreachCandidates(const vector<vector<char>>& board) {
+    size_t near[8];
+    for (size_t cell : obstacles) {
+        const char c = board[cell / columns][cell % columns];
+        if (c != WALL && c != DAMAGED_WALL) {
+            continue;
+        }
+        int found[8];
+        int foundCount = 0;
+        const int count = neighbours(cell, near);
+        for (int i = 0; i < count; ++i) {
+            const int r = regionOf[near[i]];
+            if (r != NO_REGION && std::find(found, found + foundCount, r) == found + foundCount) {
+                found[foundCount++] = r;
+            }
+        }
+        const Point at = {static_cast<int>(cell % columns), static_cast<int>(cell / columns)};
+        for (int a = 0; a < foundCount; ++a) {
+            for (int b = a + 1; b < foundCount; ++b) {
+                breaches.push_back({at, c == WALL ? 2 : 1, found[a], found[b]});
+            }
+        }
+    }
+}
+
+int MapAnalysis::distanceLowerBound(Point a, Point b) const {
+    // Moving diagonally is as fast as moving straight, so the wrapped Chebyshev distance always
+    // holds; the landmarks can only raise it
+    const int dx = std::abs(a.x - b.x);
+    const int dy = std::abs(a.y - b.y);
+    int bound = std::max(std::min(dx, columns - dx), std::min(dy, rows - dy));
+    for (size_t l = 0; l < landmarks.size(); ++l) {
+        const int da = landmarkDistance(l, a.x, a.y);
+        const int db = landmarkDistance(l, b.x, b.y);
+        if ((da == UNREACHABLE) != (db == UNREACHABLE)) {
+            return UNREACHABLE;  // Different regions
+        }
+        if (da != UNREACHABLE) {
+            bound = std::max(bound, std::abs(da - db));
+        }
+    }
+    return bound;
+}
+
+int MapAnalysis::findRoot(int i) const {
+    while (unionParent[i] != i) {
+        i = unionParent[i];
+    }
+    return i;
+}
+
+void MapAnalysis::join(int a, int b) {
+    a = findRoot(a);
+    b = findRoot(b);
+    if (a == b) {
+        return;
+    }
+    if (unionSize[a] < unionSize[b]) {
+        std::swap(a, b);
+    }
+    unionParent[b] = a;
+    unionSize[a] += unionSize[b];
+}
+
+int MapAnalysis::componentOf(size_t cell) const {
+    if (isOpen(cell)) {
+        return regionOf[cell];
+    }
+    const int obstacle = obstacleIndex[cell];
+    return opened[obstacle] ? regions + obstacle : -1;
+}
+
+void MapAnalysis::refresh(const vector<vector<char>>& board) {
+    if (static_cast<int>(board.size()) != rows || (rows > 0 && static_cast<int>(board[0].size()) != columns)) {
+        return;  // Not a view of this map
+    }
+    size_t near[8];
+    for (size_t i = 0; i < obstacles.size(); ++i) {
+        const size_t cell = obstacles[i];
+        if (opened[i] || isObstacle(board[cell / columns][cell % columns])) {
+            continue;
+        }
+        opened[i] = true;
+        ++openedCount;
+        const int count = neighbours(cell, near);
+        for (int n = 0; n < count; ++n) {
+            const int component = componentOf(near[n]);
+            if (component >= 0) {
+                join(regions + static_cast<int>(i), component);
+            }
+        }
+    }
+}
+
+bool MapAnalysis::mayBeConnected(Point a, Point b) const {
+    const int componentA = componentOf(index(a.x, a.y));
+    const int componentB = componentOf(index(b.x, b.y));
+    return componentA >= 0 && componentB >= 0 && findRoot(componentA) == findRoot(componentB);
+}
+
+} // namespace Algorithm_208000547_208000547
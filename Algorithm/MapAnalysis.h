@@ -0,0 +1,107 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "PathFinder.h"
+
+namespace Algorithm_208000547_208000547 {
+
+// One-time analysis of a map's static layout, run by the Player on the first satellite view and
+// shared by all of its tanks. Walls, damaged walls and mines are the only obstacles that stay
+// put; everything else (tanks, shells) is treated as open ground. Moves are the 8 tank moves
+// with wrap-around. Computed once:
+//  - connected regions of open cells,
+//  - choke points: open cells whose loss would split their region (articulation points),
+//  - landmarks: the tanks' starting cells, topped up with far-apart cells, with the exact move
+//    distance from each landmark to every cell; the number of landmarks shrinks on big maps to
+//    keep the tables within a fixed budget,
+//  - breach candidates: walls whose removal would join two regions.
+// Obstacles only ever disappear during a game, so refresh() just records which have opened
+// since, which keeps mayBeConnected() exact at the cost of a pass over the obstacle cells.
+class MapAnalysis {
+public:
+    static constexpr int NO_REGION = -1;
+    static constexpr uint16_t UNREACHABLE = 0xFFFF;
+
+    struct BreachCandidate {
+        Point cell;
+        int shots;  // Shells needed to bring the wall down
+        int regionA;
+        int regionB;
+    };
+
+    // The tanks' landmark tables are filled in parallel on `scheduler`, if given
+    MapAnalysis(const vector<vector<char>>& board, int rows, int columns, TaskScheduler* scheduler = nullptr);
+
+    int getRows() const { return rows; }
+    int getColumns() const { return columns; }
+
+    // Regions
+    int regionCount() const { return regions; }
+    int region(int x, int y) const { return regionOf[index(x, y)]; }  // NO_REGION for obstacles
+
+    // Choke points
+    bool isChokePoint(int x, int y) const { return chokeFlags[index(x, y)]; }
+    const vector<Point>& chokePoints() const { return chokes; }
+
+    // Landmarks and their distance tables (distances on the map as first seen)
+    size_t landmarkCount() const { return landmarks.size(); }
+    Point landmark(size_t i) const { return landmarks[i]; }
+    uint16_t landmarkDistance(size_t i, int x, int y) const {
+        return landmarkDistances[i * cellCount() + index(x, y)];
+    }
+    // Lower bound on the moves between two cells, from the landmark tables; holds on the current
+    // board only while isStatic()
+    int distanceLowerBound(Point a, Point b) const;
+
+    const vector<BreachCandidate>& breachCandidates() const { return breaches; }
+
+    // Record which obstacles have opened on `board` (a later view of the same map)
+    void refresh(const vector<vector<char>>& board);
+
+    // Whether no obstacle has opened since the analysis, so its distances are still exact
+    bool isStatic() const { return openedCount == 0; }
+
+    // Whether a path between the open cells a and b may exist on the last refreshed board
+    bool mayBeConnected(Point a, Point b) const;
+
+private:
+    int rows;
+    int columns;
+    int regions = 0;
+    vector<int> regionOf;
+    vector<bool> chokeFlags;
+    vector<Point> chokes;
+    vector<Point> landmarks;
+    vector<uint16_t> landmarkDistances;  // Landmark-major
+    vector<BreachCandidate> breaches;
+
+    // Obstacles, and for refresh(): which have opened, joined through a union-find whose first
+    // `regions` entries are the regions and the rest the obstacles
+    vector<size_t> obstacles;
+    vector<int> obstacleIndex;  // Per cell, index into `obstacles` or -1
+    vector<bool> opened;
+    size_t openedCount = 0;
+    vector<int> unionParent;
+    vector<int> unionSize;
+
+    size_t cellCount() const { return static_cast<size_t>(rows) * columns; }
+    size_t index(int x, int y) const { return static_cast<size_t>(y) * columns + x; }
+    int neighbours(size_t cell, size_t (&out)[8]) const;  // Distinct neighbours of a cell
+    bool isOpen(size_t cell) const { return regionOf[cell] != NO_REGION; }
+
+    void findRegions();
+    void findChokePoints();
+    void placeLandmarks(const vector<vector<char>>& board, TaskScheduler* scheduler);
+    void distancesFrom(size_t cell, uint16_t* out) const;  // BFS over open cells
+    // The same for the landmarks from `first` on, from a batch over the open cells, for big maps
+    void distancesFrom(size_t first, const FieldBatch& batch, TaskScheduler* scheduler);
+    void findBreachCandidates(const vector<vector<char>>& board);
+
+    int findRoot(int i) const;
+    void join(int a, int b);
+    int componentOf(size_t cell) const;  // Union-find entry of a cell, or -1 if it is blocked
+};
+
+} // namespace Algorithm_208000547_208000547
@@ -1,18 +1,30 @@
 #include "OffensiveTankAlgorithm.h"
 #include "PathFinder.h"
 #include "../UserCommon/SatelliteBattleInfo.h"
+#include "PlayerBattleInfo.h"
 #include "../common/ActionRequest.h"
 #include "../UserCommon/BoardConstants.h"
 #include "../common/TankAlgorithmRegistration.h"
+#include <algorithm>
 #include <iostream>
 #include <climits>
+#include <cstdlib>
 #include <limits>
 
 using namespace UserCommon_208000547_208000547;
 
 namespace Algorithm_208000547_208000547 {
-OffensiveTankAlgorithm::OffensiveTankAlgorithm(int player_index, int tank_index) : boardWidth(0), boardHeight(0), turnCounter(0), tankX(-1), tankY(-1),
-    dirX(0), dirY(0), directionInitialized(false), playerIndex(player_index), tankIndex(tank_index), currentMode(OperationsMode::Regular)
+namespace {
+// Rounds of shell movement the threat map looks ahead; seen shells make the belief state go
+// stale once this runs out
+constexpr int THREAT_ROUNDS = 6;
+
+// Battle info is requested once the belief state's confidence drops below this
+constexpr double BELIEF_THRESHOLD = 0.5;
+}
+
+OffensiveTankAlgorithm::OffensiveTankAlgorithm(int player_index, int tank_index) : boardWidth(0), boardHeight(0), turnCounter(0), tankX(-1), tankY(-1), enemyReachable(false),
+    direction(Direction::Left), directionInitialized(false), playerIndex(player_index), tankIndex(tank_index), currentMode(OperationsMode::Regular)
 {
     // Initialize offensive strategy
 }
@@ -23,41 +35,17 @@ OffensiveTankAlgorithm::~OffensiveTankAlgorithm()
 }
 
 bool OffensiveTankAlgorithm::shouldGetBattleInfo() const {
-    // Get battle info on first turn (turnCounter == 0) and every 4 turns after
-    return turnCounter == 0 || turnCounter % 4 == 0;
+    return belief.confidence(tankX, tankY) < BELIEF_THRESHOLD;
 }
 
 void OffensiveTankAlgorithm::updateDirection(ActionRequest action) {
-    const std::vector<std::pair<int, int>> directions = {
-        {1, 0}, {1, 1}, {0, 1}, {-1, 1},
-        {-1, 0}, {-1, -1}, {0, -1}, {1, -1}
-    };
-
-    // Find current direction index
-    int currentIndex = -1;
-    for (int i = 0; i < 8; ++i) {
-        if (directions[i].first == dirX && directions[i].second == dirY) {
-            currentIndex = i;
-            break;
-        }
-    }
-
-    if (currentIndex == -1) {
-        throw std::runtime_error("Invalid current direction");
-    }
-
-    int offset = 0;
     switch (action) {
-        case ActionRequest::RotateLeft45:  offset = -1; break;
-        case ActionRequest::RotateRight45: offset = +1; break;
-        case ActionRequest::RotateLeft90:  offset = -2; break;
-        case ActionRequest::RotateRight90: offset = +2; break;
+        case ActionRequest::RotateLeft45:  direction = direction.rotate45(false); break;
+        case ActionRequest::RotateRight45: direction = direction.rotate45(true); break;
+        case ActionRequest::RotateLeft90:  direction = direction.rotate90(false); break;
+        case ActionRequest::RotateRight90: direction = direction.rotate90(true); break;
         default: return; // no direction change
     }
-
-    int newIndex = (currentIndex + offset + 8) % 8;
-    dirX = directions[newIndex].first;
-    dirY = directions[newIndex].second;
 }
 
 
@@ -67,6 +55,12 @@ void OffensiveTankAlgorithm::updateBattleInfo(BattleInfo& info)
     
     // Cast to SatelliteBattleInfo to access its methods
     SatelliteBattleInfo& satelliteInfo = static_cast<SatelliteBattleInfo&>(info);
+    const TargetAssignment::Assignment* assignment = nullptr;
+    if (auto* playerInfo = dynamic_cast<PlayerBattleInfo*>(&info)) {
+        mapAnalysis = playerInfo->getMapAnalysis();
+        hierarchy = playerInfo->getHierarchy();
+        assignment = playerInfo->getAssignment();
+    }
     
     // Store board dimensions
     boardWidth = satelliteInfo.getColumns();
@@ -75,6 +69,7 @@ void OffensiveTankAlgorithm::updateBattleInfo(BattleInfo& info)
     
     // Get a copy of the board directly
     board = satelliteInfo.getBoard();
+    planes.rebuild(board, static_cast<size_t>(boardHeight), static_cast<size_t>(boardWidth));
     
     // Update tank position
     tankX = satelliteInfo.getTankX();
@@ -85,70 +80,224 @@ void OffensiveTankAlgorithm::updateBattleInfo(BattleInfo& info)
     playerIndex = satelliteInfo.getPlayerIndex();
     std::cout << "OffensiveTank: Player index: " << playerIndex << std::endl;
 
+    // The board shows this tank as '%'; the planes show it as a tank of its player, since it
+    // stops shells like any other tank
+    planes.setCell(tankX, tankY, playerIndex == 1 ? PLAYER1_TANK : PLAYER2_TANK);
+    belief.observe(planes, playerIndex == 1 ? BoardPlanes::Tank2 : BoardPlanes::Tank1, THREAT_ROUNDS);
+
     // Initialize direction if not done yet
     if (!directionInitialized) {
         // Player 1 starts pointing left, Player 2 starts pointing right
-        dirX = (playerIndex == 1) ? -1 : 1;
-        dirY = 0;
+        direction = (playerIndex == 1) ? Direction::Left : Direction::Right;
         directionInitialized = true;
-        std::cout << "OffensiveTank: Initialized direction - dirX: " << dirX << ", dirY: " << dirY << std::endl;
+        std::cout << "OffensiveTank: Initialized direction - dirX: " << direction.dx() << ", dirY: " << direction.dy() << std::endl;
     }
 
-    // find path to closest enemy
+    // Go for the target the Player assigned, which keeps this player's tanks spread out
     Point start = {tankX, tankY};
-    std::vector<Point> closestPath;
-    size_t minPathLength = std::numeric_limits<size_t>::max();
+    if (assignment && assignment->path.size() >= 2 && assignment->path.front() == start) {
+        pathToClosestEnemy.assign(assignment->path.begin(), assignment->path.end());
+        enemyReachable = true;
+        std::cout << "OffensiveTank: Assigned enemy at X: " << assignment->target.x << ", Y: " << assignment->target.y
+                  << ", " << assignment->path.size() << " steps" << std::endl;
+        return;
+    }
 
     // Determine enemy tank character based on player index
     char enemyTankChar = (playerIndex == 1) ? '2' : '1';  // Player 1 looks for '2', Player 2 looks for '1'
     std::cout << "OffensiveTank: Looking for enemy tank character: " << enemyTankChar << std::endl;
 
+    // The map analysis knows which enemies no wall-free path reaches; for those the search
+    // through walls, which the pathfinder would fall back to anyway, is run directly
+    const bool useAnalysis = mapAnalysis && mapAnalysis->getRows() == boardHeight && mapAnalysis->getColumns() == boardWidth;
+    const bool useHierarchy = hierarchy && hierarchy->getRows() == boardHeight && hierarchy->getColumns() == boardWidth;
+
     // Find all enemy tanks on the board
+    std::vector<Point> enemies;
     for (int y = 0; y < boardHeight; y++) {
         for (int x = 0; x < boardWidth; x++) {
-            // Check if this is an enemy tank
             if (board[y][x] == enemyTankChar) {
-                Point enemyPos = {x, y};
-                std::cout << "OffensiveTank: Found enemy at position - X: " << x << ", Y: " << y << std::endl;
-                // Find path to this enemy
-                std::vector<Point> path = bfsPathfinder(board, start, enemyPos, false);
-                
-                // If we found a valid path and it's shorter than our current closest
-                if (!path.empty() && path.size() < minPathLength) {
-                    minPathLength = path.size();
-                    closestPath = path;
-                    std::cout << "OffensiveTank: Found new closest path with length: " << path.size() << std::endl;
-                }
+                enemies.push_back({x, y});
             }
         }
     }
 
+    // Keep to the last path if patching it over the new board leaves nothing to gain
+    if (repairPath(enemies, enemyTankChar, useAnalysis)) {
+        enemyReachable = true;
+        return;
+    }
+
+    // Otherwise find path to closest enemy
+    closestPath.clear();
+    size_t minPathLength = std::numeric_limits<size_t>::max();
+    for (const Point& enemyPos : enemies) {
+        std::cout << "OffensiveTank: Found enemy at position - X: " << enemyPos.x << ", Y: " << enemyPos.y << std::endl;
+        const bool cutOff = useAnalysis && !mapAnalysis->mayBeConnected(start, enemyPos);
+        if (cutOff) {
+            std::cout << "OffensiveTank: Enemy is cut off by walls or mines" << std::endl;
+        }
+        // Find path to this enemy; on big maps only its first steps come move by move
+        if (useHierarchy) {
+            hierarchy->findPath(board, start, enemyPos, cutOff, searchContext, searchPath);
+        } else {
+            findPath(board, start, enemyPos, cutOff, searchContext, searchPath);
+        }
+        const size_t length = pathLength(searchPath, boardWidth, boardHeight) + 1;
+
+        // If we found a valid path and it's shorter than our current closest
+        if (!searchPath.empty() && length < minPathLength) {
+            minPathLength = length;
+            closestPath.swap(searchPath);
+            std::cout << "OffensiveTank: Found new closest path with length: " << length << std::endl;
+        }
+    }
+
     // Save the path to the closest enemy
+    enemyReachable = !closestPath.empty();
     if (!closestPath.empty()) {
-        pathToClosestEnemy = closestPath;
+        pathToClosestEnemy.assign(closestPath.begin(), closestPath.end());
         std::cout << "OffensiveTank: Updated path to closest enemy with " << closestPath.size() << " steps" << std::endl;
     } else {
         std::cout << "OffensiveTank: No valid path found to any enemy" << std::endl;
     }
 }
 
+bool OffensiveTankAlgorithm::repairPath(const std::vector<Point>& enemies, char enemyTank, bool useAnalysis) {
+    if (pathToClosestEnemy.size() < 2 || enemies.empty()) {
+        return false;
+    }
+    std::deque<Point> path = pathToClosestEnemy;
+    Point start = {tankX, tankY};
+
+    // The tank follows the path from its front, and its target may have moved a cell since
+    if (!(path.front() == start)) {
+        if (dist(path.front(), start, boardWidth, boardHeight) > 1) {
+            return false;
+        }
+        updatePathStart(path, start, boardWidth, boardHeight);
+    }
+    Point end = path.back();
+    if (board[end.y][end.x] != enemyTank) {
+        auto moved = std::find_if(enemies.begin(), enemies.end(),
+                                  [&](const Point& enemy) { return dist(enemy, end, boardWidth, boardHeight) <= 1; });
+        if (moved == enemies.end()) {
+            return false;
+        }
+        end = *moved;
+        updatePathEnd(path, end, boardWidth, boardHeight);
+    }
+
+    // Search again only around runs of cells that have closed (walls are shot through on the way)
+    for (size_t i = 1; i + 1 < path.size(); ++i) {
+        if (isPassable(board[path[i].y][path[i].x], true)) {
+            continue;
+        }
+        size_t resume = i + 1;
+        while (resume + 1 < path.size() && !isPassable(board[path[resume].y][path[resume].x], true)) {
+            ++resume;
+        }
+        findPath(board, path[i - 1], path[resume], false, searchContext, searchPath);
+        const std::vector<Point>& detour = searchPath;
+        if (detour.size() < 2 || pathLength(detour, boardWidth, boardHeight) + 1 != static_cast<int>(detour.size())) {
+            return false;
+        }
+        path.erase(path.begin() + i, path.begin() + resume);
+        path.insert(path.begin() + i, detour.begin() + 1, detour.end() - 1);
+        i += detour.size() - 2;
+    }
+    for (size_t i = 1; i < path.size(); ++i) {
+        if (dist(path[i - 1], path[i], boardWidth, boardHeight) != 1) {
+            return false;
+        }
+    }
+
+    // A search would only find something shorter if some enemy might be closer; wall-free
+    // distances are bounded by the map analysis, the rest only by the board's geometry
+    const int length = static_cast<int>(path.size()) - 1;
+    const bool exactAnalysis = useAnalysis && mapAnalysis->isStatic();
+    for (const Point& enemy : enemies) {
+        int bound = dist(start, enemy, boardWidth, boardHeight);
+        if (exactAnalysis && mapAnalysis->mayBeConnected(start, enemy)) {
+            bound = std::max(bound, mapAnalysis->distanceLowerBound(start, enemy));
+        }
+        if (bound < length) {
+            return false;
+        }
+    }
+
+    pathToClosestEnemy = std::move(path);
+    std::cout << "OffensiveTank: Repaired path to enemy at X: " << end.x << ", Y: " << end.y << ", "
+              << pathToClosestEnemy.size() << " steps" << std::endl;
+    return true;
+}
+
 ActionRequest OffensiveTankAlgorithm::wrapMoveForward() {
     // Calculate next position based on current direction
-    int nextX = (tankX + dirX + boardWidth) % boardWidth;
-    int nextY = (tankY + dirY + boardHeight) % boardHeight;
+    int nextX = (tankX + direction.dx() + boardWidth) % boardWidth;
+    int nextY = (tankY + direction.dy() + boardHeight) % boardHeight;
     
-    // Update board: current position becomes empty, next position becomes tank
-    board[tankY][tankX] = ' ';
-    board[nextY][nextX] = '%';
-    
-    // Update tank position
-    tankX = nextX;
-    tankY = nextY;
+    setOwnPosition(nextX, nextY);
     
     turnCounter++;
     return ActionRequest::MoveForward;
 }
 
+void OffensiveTankAlgorithm::setOwnPosition(int x, int y) {
+    // Update board: current position becomes empty, next position becomes tank
+    board[tankY][tankX] = ' ';
+    board[y][x] = '%';
+    planes.setCell(tankX, tankY, ' ');
+    planes.setCell(x, y, playerIndex == 1 ? PLAYER1_TANK : PLAYER2_TANK);
+
+    tankX = x;
+    tankY = y;
+}
+
+bool OffensiveTankAlgorithm::aimAtEnemy(ActionRequest& action) {
+    const BoardPlanes::Plane enemy = (playerIndex == 1) ? BoardPlanes::Tank2 : BoardPlanes::Tank1;
+    LineOfFire::Shot shots[8];
+    // Only this tank's own cell is ever asked about, so the rays are scanned on demand rather
+    // than keeping a table of every cell's lines of fire
+    const int count = LineOfFire::shotsAt(planes, BoardPlanes::bit(enemy), tankX, tankY, shots);
+    if (count == 0) {
+        return false;
+    }
+
+    // Prefer the enemy that takes the fewest turns to face, then the closest one
+    const LineOfFire::Shot* best = &shots[0];
+    for (int i = 1; i < count; ++i) {
+        const int turns = std::abs(direction.turnTo(shots[i].direction));
+        const int bestTurns = std::abs(direction.turnTo(best->direction));
+        if (turns < bestTurns || (turns == bestTurns && shots[i].steps < best->steps)) {
+            best = &shots[i];
+        }
+    }
+    std::cout << "OffensiveTank: Enemy in line of fire " << best->steps << " steps away (direction "
+              << best->direction.dx() << "," << best->direction.dy() << ")" << std::endl;
+
+    action = (best->direction == direction) ? wrapShoot() : turnToAction(rotation(direction, best->direction));
+    return true;
+}
+
+bool OffensiveTankAlgorithm::evadeShells(ActionRequest& action) {
+    const int next = belief.nextShellRound();
+    if (!belief.threats().isDangerous(tankX, tankY, next, next)) {
+        return false;
+    }
+
+    // Only a forward move gets out within one turn; take it if it leads somewhere safe
+    int nextX = (tankX + direction.dx() + boardWidth) % boardWidth;
+    int nextY = (tankY + direction.dy() + boardHeight) % boardHeight;
+    if (board[nextY][nextX] != EMPTY_SPACE || belief.threats().isDangerous(nextX, nextY, next - 1, next)) {
+        return false;
+    }
+    std::cout << "OffensiveTank: Shell may reach (" << tankX << "," << tankY << "), evading forward" << std::endl;
+    pathToClosestEnemy.clear();  // Off the path now, re-plan with the next battle info
+    action = wrapMoveForward();
+    return true;
+}
+
 ActionRequest OffensiveTankAlgorithm::wrapRotateLeft45() {
     updateDirection(ActionRequest::RotateLeft45);
     turnCounter++;
@@ -199,7 +348,8 @@ ActionRequest OffensiveTankAlgorithm::turnToAction(Turn t) {
 
 ActionRequest OffensiveTankAlgorithm::getAction()
 {
-    // Check if we should get battle info based on turn counter
+    // Ask for battle info once what the tank believes about the board has gone stale
+    belief.advance();
     if (shouldGetBattleInfo()) {
         turnCounter++;
         return ActionRequest::GetBattleInfo;
@@ -210,70 +360,83 @@ ActionRequest OffensiveTankAlgorithm::getAction()
         return wrapShoot();
     }
 
-    // If we have a path to the enemy, check if it's straight
-    if (!pathToClosestEnemy.empty()) {
-        if (isPathStraight(pathToClosestEnemy, boardHeight, boardWidth)) {
-            // Calculate direction to enemy
-            array<int,2> pathDir = calcDirection(pathToClosestEnemy, boardHeight, boardWidth);
-            array<int,2> currentDir = {dirX, dirY};
+    // Get out of the way of incoming shells first
+    ActionRequest action;
+    if (evadeShells(action)) {
+        return action;
+    }
 
-            // If we're facing the enemy, shoot
-            if (pathDir[0] == currentDir[0] && pathDir[1] == currentDir[1]) {
-                return wrapShoot();
-            }
-            // Otherwise, turn to face the enemy
-            else {
-                Turn t = rotation(currentDir, pathDir);
-                return turnToAction(t);
-            }
-        }
-        // If path is not straight, follow it
-        else {
-            return followPath();
-        }
+    // If an enemy is in line of fire, shoot at it or turn to face it
+    if (aimAtEnemy(action)) {
+        return action;
+    }
+
+    // Otherwise close in on the nearest enemy
+    if (pathToClosestEnemy.size() >= 2) {
+        return followPath();
     }
+
+    // No path was found with the last battle info, and until the belief state goes stale a new
+    // one would most likely show the same board: wait instead of paying a round for it
     turnCounter++;
-    return ActionRequest::GetBattleInfo;
+    return enemyReachable ? ActionRequest::GetBattleInfo : ActionRequest::DoNothing;
 }
 
 ActionRequest OffensiveTankAlgorithm::followPath() {
     std::cout << "OffensiveTank: Following path with " << pathToClosestEnemy.size() << " steps remaining" << std::endl;
     
-    Point start = pathToClosestEnemy[0];
+    Point start = {tankX, tankY};
     Point next = pathToClosestEnemy[1];
     std::cout << "OffensiveTank: Current position - X: " << start.x << ", Y: " << start.y << std::endl;
     std::cout << "OffensiveTank: Next target - X: " << next.x << ", Y: " << next.y << std::endl;
-    
-    array<int,2> dir = directionBetweenPoints(start, next);
-    array<int,2> currentDir = {dirX, dirY};
-    std::cout << "OffensiveTank: Required direction - X: " << dir[0] << ", Y: " << dir[1] << std::endl;
-    std::cout << "OffensiveTank: Current direction - X: " << currentDir[0] << ", Y: " << currentDir[1] << std::endl;
+
+    // The next cell must be one move away: a hierarchical path lists far-off entrances once its
+    // filled-in part is used up, and directionBetweenPoints() would turn those into a wrong step.
+    // Re-plan instead.
+    Direction dir;
+    array<int,2> delta = {0, 0};
+    if (dist(start, next, boardWidth, boardHeight) == 1) {
+        delta = directionBetweenPoints(start, next);
+    }
+    if (!Direction::fromDelta(delta[0], delta[1], dir)) {
+        std::cout << "OffensiveTank: Path step is not a single move, requesting battle info" << std::endl;
+        turnCounter++;
+        return ActionRequest::GetBattleInfo;
+    }
+    std::cout << "OffensiveTank: Required direction - X: " << delta[0] << ", Y: " << delta[1] << std::endl;
+    std::cout << "OffensiveTank: Current direction - X: " << direction.dx() << ", Y: " << direction.dy() << std::endl;
 
     // If we're facing the correct direction
-    if (dir[0] == currentDir[0] && dir[1] == currentDir[1]) {
+    if (dir == direction) {
         std::cout << "OffensiveTank: Facing correct direction, checking next tile" << std::endl;
         // Check next tile
-        int nextX = (tankX + dirX + boardWidth) % boardWidth;
-        int nextY = (tankY + dirY + boardHeight) % boardHeight;
+        int nextX = (tankX + direction.dx() + boardWidth) % boardWidth;
+        int nextY = (tankY + direction.dy() + boardHeight) % boardHeight;
         char tile = board[nextY][nextX];
         std::cout << "OffensiveTank: Next tile at X: " << nextX << ", Y: " << nextY << " contains: '" << tile << "'" << std::endl;
 
         // If there's a wall, shoot
-        if (tile == WALL || tile == DAMAGED_WALL) {
+        if (planes.test(BoardPlanes::BLOCKING, nextX, nextY)) {
             std::cout << "OffensiveTank: Wall detected, shooting" << std::endl;
             return wrapShoot();
         }
+        // Wait for a shell that may cross the next tile to pass
+        else if (tile == ' ' && belief.threats().isDangerous(nextX, nextY, belief.nextShellRound() - 1, belief.nextShellRound())) {
+            std::cout << "OffensiveTank: Shell may cross next tile, waiting" << std::endl;
+            turnCounter++;
+            return ActionRequest::DoNothing;
+        }
         // If path is clear, move forward
         else if (tile == ' ') {
             std::cout << "OffensiveTank: Path clear, moving forward" << std::endl;
-            pathToClosestEnemy.erase(pathToClosestEnemy.begin());
+            pathToClosestEnemy.pop_front();
             return wrapMoveForward();
         }
     }
     // Otherwise, turn to face the correct direction
     else {
         std::cout << "OffensiveTank: Need to adjust direction" << std::endl;
-        Turn t = rotation(currentDir, dir);
+        Turn t = rotation(direction, dir);
         std::cout << "OffensiveTank: Calculating turn: " << static_cast<int>(t) << std::endl;
         return turnToAction(t);
     }
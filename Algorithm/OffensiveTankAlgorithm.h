@@ -1,5 +1,6 @@
 #pragma once
 #include <cstddef>
+#include <deque>
 #include <functional>
 #include <vector>
 #include <array>
@@ -8,8 +9,13 @@
 #include "../common/ActionRequest.h"
 #include "../common/BattleInfo.h"
 #include "../common/TankAlgorithm.h"
+#include "../UserCommon/Direction.h"
 
 #include "PathFinder.h"
+#include "LineOfFire.h"
+#include "BeliefState.h"
+#include "MapAnalysis.h"
+#include "HierarchicalPathFinder.h"
 namespace Algorithm_208000547_208000547 {
     class OffensiveTankAlgorithm : public TankAlgorithm
     {
@@ -27,21 +33,28 @@ namespace Algorithm_208000547_208000547 {
 
     private:
         std::vector<std::vector<char>> board;
+        UserCommon_208000547_208000547::BoardPlanes planes;  // Bit planes of `board`, this tank included
+        BeliefState belief;  // `board` dead-reckoned since it was seen
+        std::shared_ptr<const MapAnalysis> mapAnalysis;  // From the Player; null with a foreign Player
+        std::shared_ptr<const HierarchicalPathFinder> hierarchy;  // From the Player, on big maps only
         int boardWidth;
         int boardHeight;
         int turnCounter;
         int tankX;
         int tankY;
-        int dirX;
-        int dirY;
+        bool enemyReachable;  // Whether the last battle info gave a path to an enemy
+        UserCommon_208000547_208000547::Direction direction;
         bool directionInitialized;
         int playerIndex;
         int tankIndex;
         OperationsMode currentMode;
-        std::vector<Point> pathToClosestEnemy;
+        std::deque<Point> pathToClosestEnemy;  // From this tank's cell; steps are taken off the front
+        SearchContext searchContext;  // Scratch space of the path searches, kept between them
+        std::vector<Point> searchPath;  // Path the last search found
+        std::vector<Point> closestPath;  // Shortest path to an enemy so far, swapped with searchPath
 
         // Helper functions for movement and rotation
-        bool shouldGetBattleInfo() const;
+        bool shouldGetBattleInfo() const;  // Whether the belief state has gone stale
         ActionRequest wrapMoveForward();
         ActionRequest wrapRotateLeft45();
         ActionRequest wrapRotateRight45();
@@ -51,5 +64,10 @@ namespace Algorithm_208000547_208000547 {
         ActionRequest turnToAction(Turn t);
         void updateDirection(ActionRequest action);
         ActionRequest followPath();
+        void setOwnPosition(int x, int y);  // Move this tank on the board and planes
+        bool aimAtEnemy(ActionRequest& action);  // Shoot or turn at an enemy in line of fire
+        bool evadeShells(ActionRequest& action);  // Step out of a cell a shell may reach
+        // Patch the last path onto the new board; false if a search to every enemy might do better
+        bool repairPath(const std::vector<Point>& enemies, char enemyTank, bool useAnalysis);
     }; 
 }
\ No newline at end of file
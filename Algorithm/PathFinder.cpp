@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <cmath>
 #include <array>
+#include <numeric>
 #include "../UserCommon/BoardConstants.h"
 #include "PathFinder.h"
 #include "../common/ActionRequest.h"
@@ -12,17 +13,6 @@
 using namespace std;
 using namespace UserCommon_208000547_208000547;
 
-const int directions[8][2] = {
-    {-1, 0}, //UP
-    {-1, 1}, //UP_RIGHT
-    {0, 1}, //RIGHT
-    {1, 1}, //DOWN_RIGHT
-    {1, 0}, //DOWN
-    {1, -1}, //DOWN_LEFT
-    {0, -1}, //LEFT
-    {-1, -1}, //UP_LEFT
-};
-
 bool isValid(int x, int y, const vector<vector<char>>& grid, const vector<vector<bool>>& visited, bool includeWalls) {
     if (x < 0 || x >= static_cast<int>(grid[0].size()) || y < 0 || y >= static_cast<int>(grid.size())) {
         return false;
@@ -44,12 +34,73 @@ bool isValid(int x, int y, const vector<vector<char>>& grid, const vector<vector
 }
 
 Point wrapPoint(int x, int y, int rows, int cols) {
-    x = (x + rows) % rows;
-    y = (y + cols) % cols;
+    // Any number of periods off the board, as a jump can be longer than the board
+    x = (x % rows + rows) % rows;
+    y = (y % cols + cols) % cols;
     return {x, y};
 }
 
+bool isPassable(char cell, bool includeWalls) {
+    return cell == EMPTY_SPACE || cell == PLAYER1_TANK || cell == PLAYER2_TANK ||
+           (includeWalls && (cell == WALL || cell == DAMAGED_WALL));
+}
+
+namespace {
+bool isInside(Point p, int rows, int cols) {
+    return p.x >= 0 && p.x < cols && p.y >= 0 && p.y < rows;
+}
+
+// Walk parent links (cell indices, -1 at the root) back from `cell` and return the path root first
+vector<Point> tracePath(const vector<int>& parent, int cell, int cols) {
+    vector<Point> path;
+    for (; cell != -1; cell = parent[cell]) {
+        path.push_back({cell % cols, cell / cols});
+    }
+    reverse(path.begin(), path.end());
+    return path;
+}
+
+// The same over a context's parent links, into the caller's buffer
+void tracePath(const SearchContext& context, int cell, int cols, vector<Point>& path) {
+    for (; cell != -1; cell = context.parentOf(cell)) {
+        path.push_back({cell % cols, cell / cols});
+    }
+    reverse(path.begin(), path.end());
+}
+}
+
+void SearchContext::reset(int rows, int cols) {
+    const size_t cells = static_cast<size_t>(rows) * cols;
+    if (stamp.size() < cells) {
+        stamp.assign(cells, 0);
+        parent.resize(cells);
+        ring.resize(cells);
+        cost.resize(cells);
+        epoch = 0;
+    }
+    if (++epoch == 0) {
+        // Stamps from 2^32 searches ago would read as visited
+        fill(stamp.begin(), stamp.end(), 0);
+        epoch = 1;
+    }
+    head = 0;
+    count = 0;
+    for (size_t f = 0; f < usedBuckets; ++f) {
+        buckets[f].clear();
+    }
+    usedBuckets = 0;
+}
+
 vector<Point> bfsPathfinder(const vector<vector<char>>& grid, Point start, Point end, bool includeWalls) {
+    thread_local SearchContext context;
+    vector<Point> path;
+    bfsPathfinder(grid, start, end, includeWalls, context, path);
+    return path;
+}
+
+void bfsPathfinder(const vector<vector<char>>& grid, Point start, Point end, bool includeWalls,
+                   SearchContext& context, vector<Point>& path) {
+    path.clear();
     cout << "Starting BFS pathfinding from (" << start.x << "," << start.y << ") to (" << end.x << "," << end.y << ")" << endl;
     cout << "Include walls: " << (includeWalls ? "true" : "false") << endl;
 
@@ -64,66 +115,615 @@ vector<Point> bfsPathfinder(const vector<vector<char>>& grid, Point start, Point
     if (start.y < 0 || start.y >= rows || start.x < 0 || start.x >= cols) {
         cout << "ERROR: Start point (" << start.x << "," << start.y << ") is out of bounds!" << endl;
         cout << "Grid bounds: rows=" << rows << ", cols=" << cols << endl;
-        return {};
+        return;
     }
     if (end.y < 0 || end.y >= rows || end.x < 0 || end.x >= cols) {
         cout << "ERROR: End point (" << end.x << "," << end.y << ") is out of bounds!" << endl;
         cout << "Grid bounds: rows=" << rows << ", cols=" << cols << endl;
+        return;
+    }
+
+    const int startCell = start.y * cols + start.x;
+    const int endCell = end.y * cols + end.x;
+    for (;; includeWalls = true) {
+        context.reset(rows, cols);
+        cout << "Debug: Start coordinates - x: " << start.x << ", y: " << start.y << endl;
+        context.visit(startCell, -1);
+        context.push(startCell);
+        cout << "Initialized BFS with grid size: " << rows << "x" << cols << endl;
+
+        // The queue holds one distance after the other: count down the cells left at this one
+        int distance = 0;
+        size_t atDistance = 1;
+        size_t atNext = 0;
+        while (!context.empty()) {
+            if (atDistance == 0) {
+                ++distance;
+                atDistance = atNext;
+                atNext = 0;
+            }
+            --atDistance;
+            const int cell = context.pop();
+            const Point pt = {cell % cols, cell / cols};
+            cout << "Exploring node at (" << pt.x << "," << pt.y << ") with distance " << distance << endl;
+
+            if (cell == endCell) {
+                cout << "Found path to destination!" << endl;
+                tracePath(context, cell, cols, path);
+                cout << "Path length: " << path.size() << " steps" << endl;
+                return;
+            }
+
+            // Neighbors clockwise, starting from up
+            for (int i = 0; i < 8; ++i) {
+                Direction dir = Direction(Direction::Up).rotated(i);
+                Point neighbor = wrapPoint(pt.x + dir.dx(), pt.y + dir.dy(), cols, rows);
+                const int next = neighbor.y * cols + neighbor.x;
+                if (!context.isVisited(next) && isPassable(grid[neighbor.y][neighbor.x], includeWalls)) {
+                    context.visit(next, cell);
+                    context.push(next);
+                    ++atNext;
+                    cout << "Added valid neighbor at (" << neighbor.x << "," << neighbor.y << ")" << endl;
+                }
+            }
+        }
+
+        cout << "No path found without walls, retrying with walls included" << endl;
+        if (includeWalls) {
+            return;
+        }
+    }
+}
+
+vector<Point> aStarPathfinder(const vector<vector<char>>& grid, Point start, Point end, bool includeWalls, size_t* expanded) {
+    thread_local SearchContext context;
+    vector<Point> path;
+    aStarPathfinder(grid, start, end, includeWalls, context, path, expanded);
+    return path;
+}
+
+void aStarPathfinder(const vector<vector<char>>& grid, Point start, Point end, bool includeWalls,
+                     SearchContext& context, vector<Point>& path, size_t* expanded) {
+    path.clear();
+    const int rows = grid.size();
+    const int cols = rows > 0 ? grid[0].size() : 0;
+    if (!isInside(start, rows, cols) || !isInside(end, rows, cols)) {
+        return;
+    }
+
+    // Every move costs 1 and the wrap-around Chebyshev distance never overestimates, so
+    // f = g + h takes small integer values: bucket f holds the cells to expand at that f.
+    // Cells pushed last are popped first, which prefers the deepest cell among equal f.
+    const int endCell = end.y * cols + end.x;
+    context.reset(rows, cols);
+    auto push = [&](int cell) {
+        const size_t f = context.costOf(cell) + dist({cell % cols, cell / cols}, end, cols, rows);  // dist takes the x extent first
+        context.pushBucket(f, cell);
+    };
+
+    const int startCell = start.y * cols + start.x;
+    context.visit(startCell, -1, 0);
+    push(startCell);
+    size_t count = 0;
+    for (size_t f = 0; f < context.bucketCount(); ++f) {
+        int cell;
+        while (context.popBucket(f, cell)) {
+            const Point pt = {cell % cols, cell / cols};
+            const int g = context.costOf(cell);
+            if (static_cast<size_t>(g) + dist(pt, end, cols, rows) != f) {
+                continue;  // Reached more cheaply after this entry was queued
+            }
+            ++count;
+            if (cell == endCell) {
+                if (expanded) {
+                    *expanded = count;
+                }
+                cout << "A*: path length " << g + 1 << ", expanded " << count << " cells" << endl;
+                tracePath(context, cell, cols, path);
+                return;
+            }
+            for (int i = 0; i < 8; ++i) {
+                Direction dir = Direction(Direction::Up).rotated(i);
+                const Point next = wrapPoint(pt.x + dir.dx(), pt.y + dir.dy(), cols, rows);
+                const int nextCell = next.y * cols + next.x;
+                if ((!context.isVisited(nextCell) || context.costOf(nextCell) > g + 1) && nextCell != startCell &&
+                    isPassable(grid[next.y][next.x], includeWalls)) {
+                    context.visit(nextCell, cell, g + 1);
+                    push(nextCell);
+                }
+            }
+        }
+    }
+    if (expanded) {
+        *expanded = count;
+    }
+}
+
+vector<Point> bidirectionalPathfinder(const vector<vector<char>>& grid, Point start, Point end, bool includeWalls, size_t* expanded) {
+    const int rows = grid.size();
+    const int cols = rows > 0 ? grid[0].size() : 0;
+    if (!isInside(start, rows, cols) || !isInside(end, rows, cols)) {
         return {};
     }
+    const int cells = rows * cols;
+    const int startCell = start.y * cols + start.x;
+    const int endCell = end.y * cols + end.x;
+    if (startCell == endCell) {
+        return {start};
+    }
+    if (!isPassable(grid[end.y][end.x], includeWalls)) {
+        return {};  // The forward search could never enter it
+    }
 
-    cout << "Debug: Creating visited array" << endl;
-    vector<vector<bool>> visited(rows, vector<bool>(cols, false));
-    cout << "Debug: Creating parent array" << endl;
-    vector<vector<Point>> parent(rows, vector<Point>(cols, {-1, -1}));
-
-    cout << "Debug: Creating queue" << endl;
-    queue<Node> q;
-    cout << "Debug: Setting start position as visited" << endl;
-    cout << "Debug: Start coordinates - x: " << start.x << ", y: " << start.y << endl;
-    visited[start.y][start.x] = true;
-    cout << "Debug: Successfully set start position as visited" << endl;
-    cout << "Debug: Pushing start node to queue" << endl;
-    q.push({start, 0});
-    cout << "Initialized BFS with grid size: " << rows << "x" << cols << endl;
-
-    while (!q.empty()) {
-        Node current = q.front();
-        q.pop();
-
-        Point pt = current.pt;
-        cout << "Exploring node at (" << pt.x << "," << pt.y << ") with distance " << current.dist << endl;
-
-        if (pt.x == end.x && pt.y == end.y) {
-            cout << "Found path to destination!" << endl;
-            // Reconstruct path
-            vector<Point> path;
-            while (!(pt.x == -1 && pt.y == -1)) {
-                path.push_back(pt);
-                pt = parent[pt.y][pt.x];
+    // side 0 grows from the start, side 1 from the end. Moves are symmetric, so the backward
+    // side searches the same graph; only the start cell is exempt from the passability check.
+    vector<int> depth[2] = {vector<int>(cells, -1), vector<int>(cells, -1)};
+    vector<int> parent[2] = {vector<int>(cells, -1), vector<int>(cells, -1)};
+    vector<int> frontier[2] = {{startCell}, {endCell}};
+    depth[0][startCell] = 0;
+    depth[1][endCell] = 0;
+    size_t count = 0;
+    int meet = -1;
+    int best = -1;
+
+    vector<int> nextFrontier;
+    while (meet < 0 && !frontier[0].empty() && !frontier[1].empty()) {
+        // Grow the smaller side by one whole level, then take the best meeting cell of that level
+        const int side = frontier[0].size() <= frontier[1].size() ? 0 : 1;
+        const int other = 1 - side;
+        nextFrontier.clear();
+        for (int cell : frontier[side]) {
+            ++count;
+            const Point pt = {cell % cols, cell / cols};
+            for (int i = 0; i < 8; ++i) {
+                Direction dir = Direction(Direction::Up).rotated(i);
+                const Point next = wrapPoint(pt.x + dir.dx(), pt.y + dir.dy(), cols, rows);
+                const int nextCell = next.y * cols + next.x;
+                if (depth[side][nextCell] >= 0 ||
+                    (nextCell != startCell && !isPassable(grid[next.y][next.x], includeWalls))) {
+                    continue;
+                }
+                depth[side][nextCell] = depth[side][cell] + 1;
+                parent[side][nextCell] = cell;
+                nextFrontier.push_back(nextCell);
+                if (depth[other][nextCell] >= 0) {
+                    const int length = depth[side][nextCell] + depth[other][nextCell];
+                    if (best < 0 || length < best) {
+                        best = length;
+                        meet = nextCell;
+                    }
+                }
             }
-            reverse(path.begin(), path.end());
-            cout << "Path length: " << path.size() << " steps" << endl;
-            return path;
         }
+        frontier[side].swap(nextFrontier);
+    }
+    if (expanded) {
+        *expanded = count;
+    }
+    if (meet < 0) {
+        return {};
+    }
+
+    // Start to the meeting cell, then on along the end side's parents
+    vector<Point> path = tracePath(parent[0], meet, cols);
+    for (int cell = parent[1][meet]; cell != -1; cell = parent[1][cell]) {
+        path.push_back({cell % cols, cell / cols});
+    }
+    cout << "Bidirectional: path length " << path.size() << ", expanded " << count << " cells" << endl;
+    return path;
+}
+
+namespace {
+constexpr int MAX_JUMP = 32;
+
+// The grid as seen by jump-point search: wrap-around moves, and the start cell passable whatever
+// is drawn on it
+struct JumpGrid {
+    const vector<vector<char>>& grid;
+    int rows;
+    int cols;
+    Point start;
+    Point end;
+    bool includeWalls;
+
+    Point wrap(int x, int y) const { return wrapPoint(x, y, cols, rows); }
+    bool open(int x, int y) const {
+        const Point p = wrap(x, y);
+        return p == start || isPassable(grid[p.y][p.x], includeWalls);
+    }
+
+    // Whether a straight move (dx, 0) or (0, dy) into (x, y) has a forced neighbour: a cell next
+    // to the line whose shortest way round the blocked cell beside it is through (x, y)
+    bool forcedStraight(int x, int y, int dx, int dy) const {
+        if (dx != 0) {
+            return (!open(x, y + 1) && open(x + dx, y + 1)) || (!open(x, y - 1) && open(x + dx, y - 1));
+        }
+        return (!open(x + 1, y) && open(x + 1, y + dy)) || (!open(x - 1, y) && open(x - 1, y + dy));
+    }
+    bool forcedDiagonal(int x, int y, int dx, int dy) const {
+        return (!open(x - dx, y) && open(x - dx, y + dy)) || (!open(x, y - dy) && open(x + dx, y - dy));
+    }
+
+    // Moves before a jump in this direction is back where it started
+    int cycleLength(int dx, int dy) const {
+        return dy == 0 ? cols : dx == 0 ? rows : cols / gcd(cols, rows) * rows;
+    }
 
-        for (const auto& dir : directions) {
-            Point neighbor = wrapPoint(pt.x + dir[1], pt.y + dir[0], cols, rows);
-            if (isValid(neighbor.x, neighbor.y, grid, visited, includeWalls)) {
-                visited[neighbor.y][neighbor.x] = true;
-                parent[neighbor.y][neighbor.x] = pt;
-                q.push({neighbor, current.dist + 1});
-                cout << "Added valid neighbor at (" << neighbor.x << "," << neighbor.y << ")" << endl;
+    // Walk from `from` in direction (dx, dy) to the next jump point: the end, a cell with a forced
+    // neighbour, or for diagonals a cell from which a straight jump finds one. Returns the number
+    // of moves, or 0 if there is none; `scanned` counts the cells looked at.
+    // On a wrap-around board an open line is endless, and every diagonal step scans two straight
+    // lines, so long jumps cost more than they save. With `bounded`, a jump stops after MAX_JUMP
+    // moves at the cell it reached. That keeps the path optimal: the cell is expanded in the same
+    // direction and the jump goes on from there.
+    int jump(Point from, int dx, int dy, size_t& scanned, bool bounded = true) const {
+        const int cycle = cycleLength(dx, dy);
+        const int limit = bounded ? min(cycle, MAX_JUMP) : cycle;
+        int x = from.x;
+        int y = from.y;
+        for (int steps = 1; steps <= limit; ++steps) {
+            const Point p = wrap(x + dx, y + dy);
+            x = p.x;
+            y = p.y;
+            ++scanned;
+            if (!open(x, y)) {
+                return 0;
+            }
+            if (p == end) {
+                return steps;
+            }
+            if (dx != 0 && dy != 0) {
+                if (forcedDiagonal(x, y, dx, dy) || jump(p, dx, 0, scanned, false) > 0 || jump(p, 0, dy, scanned, false) > 0) {
+                    return steps;
+                }
+            } else if (forcedStraight(x, y, dx, dy)) {
+                return steps;
             }
         }
+        return limit < cycle ? limit : 0;
+    }
+};
+}
+
+vector<Point> jumpPointPathfinder(const vector<vector<char>>& grid, Point start, Point end, bool includeWalls, size_t* expanded) {
+    const int rows = grid.size();
+    const int cols = rows > 0 ? grid[0].size() : 0;
+    if (!isInside(start, rows, cols) || !isInside(end, rows, cols)) {
+        return {};
+    }
+    if (!(start == end) && !isPassable(grid[end.y][end.x], includeWalls)) {
+        return {};
     }
+    const JumpGrid jg{grid, rows, cols, start, end, includeWalls};
+
+    // A* over jump points, on the same bucket queue as aStarPathfinder. Each jump point remembers
+    // the direction it was reached in, which decides the directions worth jumping on from it.
+    const int cells = rows * cols;
+    const int endCell = end.y * cols + end.x;
+    vector<int> g(cells, -1);
+    vector<int> parent(cells, -1);
+    vector<signed char> arrivalX(cells, 0);
+    vector<signed char> arrivalY(cells, 0);
+    vector<vector<int>> bucket;
+    auto push = [&](int cell) {
+        const size_t f = g[cell] + dist({cell % cols, cell / cols}, end, cols, rows);  // dist takes the x extent first
+        if (f >= bucket.size()) {
+            bucket.resize(f + 1);
+        }
+        bucket[f].push_back(cell);
+    };
+
+    const int startCell = start.y * cols + start.x;
+    g[startCell] = 0;
+    push(startCell);
+    size_t count = 0;
+    size_t scanned = 0;
+    int found = -1;
+    for (size_t f = 0; f < bucket.size() && found < 0; ++f) {
+        while (!bucket[f].empty()) {
+            const int cell = bucket[f].back();
+            bucket[f].pop_back();
+            const Point pt = {cell % cols, cell / cols};
+            if (static_cast<size_t>(g[cell]) + dist(pt, end, cols, rows) != f) {
+                continue;  // Reached more cheaply after this entry was queued
+            }
+            ++count;
+            if (cell == endCell) {
+                found = cell;
+                break;
+            }
+
+            // Directions to jump in: all from the start; otherwise straight on, the straight
+            // parts of a diagonal, and towards forced neighbours
+            int dirs[8][2];
+            int dirCount = 0;
+            const int dx = arrivalX[cell];
+            const int dy = arrivalY[cell];
+            auto add = [&](int x, int y) { dirs[dirCount][0] = x; dirs[dirCount][1] = y; ++dirCount; };
+            if (cell == startCell) {
+                for (int i = 0; i < 8; ++i) {
+                    Direction dir = Direction(Direction::Up).rotated(i);
+                    add(dir.dx(), dir.dy());
+                }
+            } else if (dx != 0 && dy != 0) {
+                add(dx, dy);
+                add(dx, 0);
+                add(0, dy);
+                if (!jg.open(pt.x - dx, pt.y)) add(-dx, dy);
+                if (!jg.open(pt.x, pt.y - dy)) add(dx, -dy);
+            } else if (dx != 0) {
+                add(dx, 0);
+                if (!jg.open(pt.x, pt.y + 1)) add(dx, 1);
+                if (!jg.open(pt.x, pt.y - 1)) add(dx, -1);
+            } else {
+                add(0, dy);
+                if (!jg.open(pt.x + 1, pt.y)) add(1, dy);
+                if (!jg.open(pt.x - 1, pt.y)) add(-1, dy);
+            }
 
-    cout << "No path found without walls, retrying with walls included" << endl;
-    if (includeWalls) {
+            for (int i = 0; i < dirCount; ++i) {
+                const int steps = jg.jump(pt, dirs[i][0], dirs[i][1], scanned);
+                if (steps == 0) {
+                    continue;
+                }
+                const Point next = wrapPoint(pt.x + dirs[i][0] * steps, pt.y + dirs[i][1] * steps, cols, rows);
+                const int nextCell = next.y * cols + next.x;
+                if (nextCell != startCell && (g[nextCell] < 0 || g[nextCell] > g[cell] + steps)) {
+                    g[nextCell] = g[cell] + steps;
+                    parent[nextCell] = cell;
+                    arrivalX[nextCell] = static_cast<signed char>(dirs[i][0]);
+                    arrivalY[nextCell] = static_cast<signed char>(dirs[i][1]);
+                    push(nextCell);
+                }
+            }
+        }
+    }
+    if (expanded) {
+        *expanded = count;
+    }
+    if (found < 0) {
         return {};
     }
 
-    return bfsPathfinder(grid, start, end, true);
+    // Fill in the cells between jump points, so the path moves one cell at a time like the others
+    vector<Point> jumpPoints = tracePath(parent, found, cols);
+    vector<Point> path = {jumpPoints.front()};
+    for (size_t i = 1; i < jumpPoints.size(); ++i) {
+        const int cell = jumpPoints[i].y * cols + jumpPoints[i].x;
+        for (int step = g[cell] - g[parent[cell]]; step > 0; --step) {
+            const Point& last = path.back();
+            path.push_back(wrapPoint(last.x + arrivalX[cell], last.y + arrivalY[cell], cols, rows));
+        }
+    }
+    cout << "JPS: path length " << path.size() << ", expanded " << count << " jump points, scanned "
+         << scanned << " cells" << endl;
+    return path;
+}
+
+SearchStrategy chooseStrategy(int rows, int cols) {
+    // On small boards a plain breadth-first search is as quick as anything and keeps its
+    // tie-breaking between equally short paths; on bigger ones the heuristic pays off
+    const long cells = static_cast<long>(rows) * cols;
+    return cells <= 4096 ? SearchStrategy::BreadthFirst : SearchStrategy::AStar;
+}
+
+vector<Point> findPath(const vector<vector<char>>& grid, Point start, Point end, bool includeWalls, SearchStrategy strategy) {
+    thread_local SearchContext context;
+    vector<Point> path;
+    findPath(grid, start, end, includeWalls, context, path, strategy);
+    return path;
+}
+
+void findPath(const vector<vector<char>>& grid, Point start, Point end, bool includeWalls,
+              SearchContext& context, vector<Point>& path, SearchStrategy strategy) {
+    if (strategy == SearchStrategy::Auto) {
+        strategy = chooseStrategy(grid.size(), grid.empty() ? 0 : grid[0].size());
+    }
+    switch (strategy) {
+        case SearchStrategy::AStar:
+            aStarPathfinder(grid, start, end, includeWalls, context, path);
+            break;
+        case SearchStrategy::Bidirectional:
+            path = bidirectionalPathfinder(grid, start, end, includeWalls);
+            break;
+        case SearchStrategy::JumpPoint:
+            path = jumpPointPathfinder(grid, start, end, includeWalls);
+            break;
+        default:
+            bfsPathfinder(grid, start, end, includeWalls, context, path);  // Retries through walls itself
+            return;
+    }
+    if (path.empty() && !includeWalls) {
+        findPath(grid, start, end, true, context, path, strategy);
+    }
+}
+
+WavefrontField::WavefrontField(int rows, int cols)
+    : rows(rows), cols(cols), words((static_cast<size_t>(cols) + 63) / 64),
+      lastMask(cols % 64 == 0 ? ~uint64_t{0} : (uint64_t{1} << (cols % 64)) - 1),
+      open(static_cast<size_t>(rows) * words, 0), visited(open.size()), front(open.size()), spread(open.size()) {}
+
+void WavefrontField::setOpen(int x, int y, bool isOpen) {
+    uint64_t& word = row(open, y)[x / 64];
+    const uint64_t bit = uint64_t{1} << (x % 64);
+    word = isOpen ? word | bit : word & ~bit;
+}
+
+void WavefrontField::spreadRow(int y) {
+    const uint64_t* in = row(front, y);
+    uint64_t* out = row(spread, y);
+    for (size_t i = 0; i < words; ++i) {
+        const uint64_t east = (in[i] << 1) | (i > 0 ? in[i - 1] >> 63 : 0);
+        const uint64_t west = (in[i] >> 1) | (i + 1 < words ? in[i + 1] << 63 : 0);
+        out[i] = in[i] | east | west;
+    }
+    // Wrap around: the last cell spreads east to the first, the first west to the last
+    const int last = cols - 1;
+    if ((in[last / 64] >> (last % 64)) & 1) {
+        out[0] |= 1;
+    }
+    if (in[0] & 1) {
+        out[last / 64] |= uint64_t{1} << (last % 64);
+    }
+    out[words - 1] &= lastMask;
+}
+
+void WavefrontField::distances(const vector<Point>& sources, vector<int>& out) {
+    out.resize(static_cast<size_t>(rows) * cols);
+    distances(sources, out.data());
+}
+
+void WavefrontField::distances(const vector<Point>& sources, int* out) {
+    fill(out, out + static_cast<size_t>(rows) * cols, -1);
+    fill(visited.begin(), visited.end(), 0);
+    frontMark.assign(rows, -1);
+    nextMark.assign(rows, -1);
+    frontRows.clear();
+    for (const Point& source : sources) {
+        if (!isInside(source, rows, cols)) {
+            continue;
+        }
+        if (frontMark[source.y] != 0) {
+            frontMark[source.y] = 0;
+            frontRows.push_back(source.y);
+            fill(row(front, source.y), row(front, source.y) + words, 0);
+        }
+        row(front, source.y)[source.x / 64] |= uint64_t{1} << (source.x % 64);
+        row(visited, source.y)[source.x / 64] |= uint64_t{1} << (source.x % 64);
+        out[static_cast<size_t>(source.y) * cols + source.x] = 0;
+    }
+
+    // Each round every candidate row, one next to the front, reads the spread front rows and
+    // writes its own new front in place; `frontMark` tells the old front rows apart until all
+    // candidates are done
+    for (int distance = 1; !frontRows.empty(); ++distance) {
+        const int round = distance - 1;
+        for (int y : frontRows) {
+            spreadRow(y);
+        }
+        nextRows.clear();
+        for (int y : frontRows) {
+            for (int dy = -1; dy <= 1; ++dy) {
+                const int candidate = (y + dy + rows) % rows;
+                if (nextMark[candidate] != distance) {
+                    nextMark[candidate] = distance;
+                    nextRows.push_back(candidate);
+                }
+            }
+        }
+
+        size_t kept = 0;
+        for (int y : nextRows) {
+            const int above = (y - 1 + rows) % rows;
+            const int below = (y + 1) % rows;
+            const uint64_t* up = frontMark[above] == round ? row(spread, above) : nullptr;
+            const uint64_t* mid = frontMark[y] == round ? row(spread, y) : nullptr;
+            const uint64_t* down = frontMark[below] == round ? row(spread, below) : nullptr;
+            const uint64_t* openRow = row(open, y);
+            uint64_t* seen = row(visited, y);
+            uint64_t* next = row(front, y);
+            int* outRow = out + static_cast<size_t>(y) * cols;
+            uint64_t any = 0;
+            for (size_t i = 0; i < words; ++i) {
+                const uint64_t reach = (up ? up[i] : 0) | (mid ? mid[i] : 0) | (down ? down[i] : 0);
+                const uint64_t fresh = reach & openRow[i] & ~seen[i];
+                next[i] = fresh;
+                seen[i] |= fresh;
+                any |= fresh;
+                for (uint64_t w = fresh; w != 0; w &= w - 1) {
+                    outRow[i * 64 + __builtin_ctzll(w)] = distance;
+                }
+            }
+            if (any != 0) {
+                nextRows[kept++] = y;
+            }
+        }
+        nextRows.resize(kept);
+        for (int y : nextRows) {
+            frontMark[y] = distance;
+        }
+        swap(frontRows, nextRows);
+    }
+}
+
+void FieldBatch::distances(const vector<Point>& sources, vector<int>& out, TaskScheduler* scheduler) const {
+    out.resize(sources.size() * cells);
+    const size_t blocks = scheduler ? min(sources.size(), scheduler->concurrency()) : min<size_t>(sources.size(), 1);
+    auto runBlock = [&](size_t block) {
+        WavefrontField field = layout;
+        for (size_t s = sources.size() * block / blocks; s < sources.size() * (block + 1) / blocks; ++s) {
+            field.distances({sources[s]}, out.data() + s * cells);
+        }
+    };
+    if (blocks > 1) {
+        scheduler->runAll(blocks, runBlock);
+    } else if (blocks == 1) {
+        runBlock(0);
+    }
+}
+
+FieldStrategy chooseFieldStrategy(int rows, int cols) {
+    // Below a few thousand cells a field takes microseconds either way
+    const long cells = static_cast<long>(rows) * cols;
+    return cells <= 4096 ? FieldStrategy::Queue : FieldStrategy::Wavefront;
+}
+
+void distanceField(const vector<vector<char>>& grid, const vector<Point>& sources, bool includeWalls, vector<int>& out,
+                   FieldStrategy strategy) {
+    const int rows = grid.size();
+    const int cols = rows > 0 ? grid[0].size() : 0;
+    if (strategy == FieldStrategy::Auto) {
+        strategy = chooseFieldStrategy(rows, cols);
+    }
+    if (strategy == FieldStrategy::Wavefront) {
+        WavefrontField field(rows, cols);
+        for (int y = 0; y < rows; ++y) {
+            for (int x = 0; x < cols; ++x) {
+                if (isPassable(grid[y][x], includeWalls)) {
+                    field.setOpen(x, y, true);
+                }
+            }
+        }
+        field.distances(sources, out);
+        return;
+    }
+
+    out.assign(static_cast<size_t>(rows) * cols, -1);
+    vector<int> queue;
+    for (const Point& source : sources) {
+        const int cell = source.y * cols + source.x;
+        if (isInside(source, rows, cols) && out[cell] < 0) {
+            out[cell] = 0;
+            queue.push_back(cell);
+        }
+    }
+    for (size_t head = 0; head < queue.size(); ++head) {
+        const int cell = queue[head];
+        for (int i = 0; i < 8; ++i) {
+            const Direction dir = Direction(Direction::Up).rotated(i);
+            const Point next = wrapPoint(cell % cols + dir.dx(), cell / cols + dir.dy(), cols, rows);
+            const int nextCell = next.y * cols + next.x;
+            if (out[nextCell] < 0 && isPassable(grid[next.y][next.x], includeWalls)) {
+                out[nextCell] = out[cell] + 1;
+                queue.push_back(nextCell);
+            }
+        }
+    }
+}
+
+void distanceFields(const vector<vector<char>>& grid, const vector<Point>& sources, bool includeWalls, vector<int>& out,
+                    TaskScheduler* scheduler) {
+    const int rows = grid.size();
+    const int cols = rows > 0 ? grid[0].size() : 0;
+    FieldBatch batch(rows, cols);
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < cols; ++x) {
+            if (isPassable(grid[y][x], includeWalls)) {
+                batch.setOpen(x, y, true);
+            }
+        }
+    }
+    batch.distances(sources, out, scheduler);
 }
 
 int dist(Point p1, Point p2, int rows, int cols) {
@@ -136,7 +736,15 @@ int distArr(array<int,2> p1, array<int,2> p2, int rows, int cols) {
     return dist({p1[0], p1[1]}, {p2[0], p2[1]}, rows, cols);
 }
 
-void updatePathEnd(vector<Point> &path, Point &newEnd, int rows, int cols) {
+int pathLength(const vector<Point>& path, int width, int height) {
+    int length = 0;
+    for (size_t i = 1; i < path.size(); ++i) {
+        length += dist(path[i - 1], path[i], width, height);
+    }
+    return length;
+}
+
+void updatePathEnd(deque<Point> &path, Point &newEnd, int rows, int cols) {
     Point end = path.back();
     path.pop_back();
     if (newEnd == end) {
@@ -167,38 +775,41 @@ void updatePathEnd(vector<Point> &path, Point &newEnd, int rows, int cols) {
     }
 }
 
-void updatePathStart(vector<Point> &path, Point &newStart, int rows, int cols) {
+void updatePathStart(deque<Point> &path, Point &newStart, int rows, int cols) {
     Point start = path.front();
-    path.erase(path.begin());
+    path.pop_front();
     if (newStart == start) {
-        path.insert(path.begin(), start);
+        path.push_front(start);
     }
     else if (path.size() > 1) {
         Point nearStart = path.front();
-        path.erase(path.begin());
+        path.pop_front();
         if (!(newStart == nearStart)) {
             if (dist(start, newStart, rows, cols) >= dist(nearStart, newStart, rows, cols)) {
                 if (!path.empty()) {
                     Point nearNearStart = path.front();
                     if (dist(newStart, nearNearStart, rows, cols) > 1) {
-                        path.insert(path.begin(), nearStart);
+                        path.push_front(nearStart);
                     }
                 }
             }
             else {
-                path.insert(path.begin(), nearStart);
-                path.insert(path.begin(), start);
+                path.push_front(nearStart);
+                path.push_front(start);
             }
         }
-        path.insert(path.begin(), newStart);
+        path.push_front(newStart);
     } else {
         if(dist(newStart, path.back(), rows, cols) > 1)
-            path.insert(path.begin(), start);
-        path.insert(path.begin(), newStart);
+            path.push_front(start);
+        path.push_front(newStart);
     }
 }
 
 array<int,2> calcDirection(vector<Point> &path, int rows, int columns) {
+    if (path.size() < 2) {
+        return {0, 0};  // No step to take
+    }
     Point *start = &path[0];
     Point *next = &path[1];
     int dx, dy;
@@ -242,13 +853,11 @@ bool isPathStraight(vector<Point> &path, int rows, int columns) {
     return true;
 }
 
-bool isPathClear(vector<Point> &path, const vector<vector<char>>& grid) {
+bool isPathClear(vector<Point> &path, const BoardPlanes& planes) {
+    const BoardPlanes::PlaneMask obstacles =
+        BoardPlanes::BLOCKING | BoardPlanes::bit(BoardPlanes::Mine) | BoardPlanes::bit(BoardPlanes::Shell);
     for (Point &p: path) {
-        char tile = grid[p.y][p.x];
-        if (tile == WALL ||
-                tile == DAMAGED_WALL ||
-                tile == MINE ||
-                tile == SHELL)
+        if (planes.test(obstacles, static_cast<size_t>(p.x), static_cast<size_t>(p.y)))
                 return false;
     }
     return true;
@@ -262,49 +871,8 @@ void printPath(const vector<Point>& path) {
 }
 
 
-int inverseMap(array<int, 2> d) {
-    for(int i = 0; i < 8; ++i) {
-        if (directions[i][0] == d[0] && directions[i][1] == d[1]) {
-            return i;
-        }
-    }
-    return -1; // Return -1 if direction not found
-}
-
-
-int getRotation45(array<int, 2> from, array<int, 2> to) {
-    // All 8 directions in clockwise order
-    const vector<array<int, 2>> directions = {
-        {1, 0},   // 0 - right
-        {1, 1},   // 1 - down-right
-        {0, 1},   // 2 - down
-        {-1, 1},  // 3 - down-left
-        {-1, 0},  // 4 - left
-        {-1, -1}, // 5 - up-left
-        {0, -1},  // 6 - up
-        {1, -1}   // 7 - up-right
-    };
-
-    int fromIndex = -1, toIndex = -1;
-    for (int i = 0; i < 8; ++i) {
-        if (directions[i] == from) fromIndex = i;
-        if (directions[i] == to) toIndex = i;
-    }
-
-    if (fromIndex == -1 || toIndex == -1) {
-        throw std::invalid_argument("Invalid direction vector");
-    }
-
-    int delta = toIndex - fromIndex;
-    if (delta > 4) delta -= 8;
-    if (delta < -4) delta += 8;
-    return delta;
-}
-
-
-Turn rotation(array<int,2> currDir, array<int,2> newDir) {
-
-    return Turn(getRotation45(currDir, newDir));
+Turn rotation(Direction currDir, Direction newDir) {
+    return Turn(currDir.turnTo(newDir));
 }
 
 
@@ -1,11 +1,17 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
+#include <deque>
 #include <queue>
 #include <stack>
 #include <algorithm>
 #include <cmath>
 #include "../UserCommon/BoardConstants.h"
+#include "../UserCommon/Direction.h"
+#include "../UserCommon/BoardPlanes.h"
+#include "../UserCommon/TaskScheduler.h"
 #include "../common/ActionRequest.h"
 
 using namespace std;
@@ -23,6 +29,141 @@ struct Node {
     int dist;
 };
 
+// Scratch space for bfsPathfinder and aStarPathfinder, kept between searches so that once its
+// buffers have grown to the grid a search allocates nothing. Not to be shared between threads.
+class SearchContext {
+public:
+    // Size the buffers for rows x cols cells and forget the previous search, in O(1) unless they grow
+    void reset(int rows, int cols);
+
+    bool isVisited(int cell) const { return stamp[cell] == epoch; }
+    void visit(int cell, int from) {
+        stamp[cell] = epoch;
+        parent[cell] = from;
+    }
+    int parentOf(int cell) const { return parent[cell]; }
+
+    // A*: the cost a visited cell was reached at, and a bucket queue of cells by f = g + h
+    void visit(int cell, int from, int g) {
+        visit(cell, from);
+        cost[cell] = g;
+    }
+    int costOf(int cell) const { return cost[cell]; }
+    size_t bucketCount() const { return usedBuckets; }
+    void pushBucket(size_t f, int cell) {
+        if (f >= buckets.size()) {
+            buckets.resize(f + 1);
+        }
+        usedBuckets = max(usedBuckets, f + 1);
+        buckets[f].push_back(cell);
+    }
+    bool popBucket(size_t f, int& cell) {
+        if (buckets[f].empty()) {
+            return false;
+        }
+        cell = buckets[f].back();
+        buckets[f].pop_back();
+        return true;
+    }
+
+    // FIFO of cells on a ring buffer with a slot per cell, as a cell is queued at most once per search
+    bool empty() const { return count == 0; }
+    void push(int cell) {
+        size_t tail = head + count++;
+        ring[tail < ring.size() ? tail : tail - ring.size()] = cell;
+    }
+    int pop() {
+        const int cell = ring[head];
+        head = head + 1 < ring.size() ? head + 1 : 0;
+        --count;
+        return cell;
+    }
+
+private:
+    vector<uint32_t> stamp;  // Per cell, the epoch it was last visited in
+    uint32_t epoch = 0;
+    vector<int> parent;      // Per cell, the cell it was reached from; -1 at the start
+    vector<int> ring;
+    size_t head = 0;
+    size_t count = 0;
+    vector<int> cost;             // Per cell, the cost it was reached at (A* only)
+    vector<vector<int>> buckets;  // Kept with their capacity; only the first usedBuckets are in use
+    size_t usedBuckets = 0;
+};
+
+// Point-to-point search strategies, all returning a shortest path (start and end included) over
+// the same cells as bfsPathfinder
+enum class SearchStrategy {
+    Auto,           // chooseStrategy() by grid size
+    BreadthFirst,   // bfsPathfinder
+    AStar,          // A* with the wrap-around Chebyshev distance as heuristic, on a bucket queue
+    Bidirectional,  // Breadth-first from both ends, meeting in the middle
+    JumpPoint       // Jump-point search: A* over the cells where a shortest path may turn
+};
+
+// Ways to fill a distance field, all giving the same distances
+enum class FieldStrategy {
+    Auto,       // chooseFieldStrategy() by grid size
+    Queue,      // Breadth-first search, one cell at a time
+    Wavefront   // WavefrontField, 64 cells at a time
+};
+
+// Bit-parallel breadth-first waves over a wrap-around grid. Each row of open cells is a run of
+// 64-bit words, and the whole front advances one move per round: spread each front row one cell
+// east and west, OR it into the rows above and below, and keep the open cells not reached yet.
+// Only rows next to the front are touched, so a narrow front in a maze costs a few words per
+// move while a wide one on an open board covers 64 cells per word operation. Buffers are kept
+// between fields.
+class WavefrontField {
+public:
+    WavefrontField(int rows, int cols);
+
+    void setOpen(int x, int y, bool open);
+
+    // Moves from the nearest of `sources` to every cell, row-major, -1 where unreachable; the
+    // sources count as open
+    void distances(const vector<Point>& sources, vector<int>& out);
+    void distances(const vector<Point>& sources, int* out);  // Into rows * cols ints
+
+private:
+    int rows;
+    int cols;
+    size_t words;       // Per row
+    uint64_t lastMask;  // Cells of a row's last word
+    vector<uint64_t> open;
+    vector<uint64_t> visited;
+    vector<uint64_t> front;
+    vector<uint64_t> spread;  // Front rows spread east and west
+    vector<int> frontRows;
+    vector<int> nextRows;
+    vector<int> frontMark;  // Per row, the round it was last in the front
+    vector<int> nextMark;   // Per row, the round it was last a candidate for the next front
+
+    uint64_t* row(vector<uint64_t>& plane, int y) { return plane.data() + static_cast<size_t>(y) * words; }
+    void spreadRow(int y);
+};
+
+// A distance field per source, for many sources at once. The open cells are laid out once for
+// the batch; the sources are cut into a block per thread of the TaskScheduler (one block without
+// one), and each block runs its sources through its own copy of the WavefrontField, keeping its
+// buffers from one source to the next. Sharing the waves instead, with a bit per source of a
+// block in every cell, did not pay: scattered sources reach a cell in different rounds, so each
+// cell still joined the front once per source, with eight times the state to carry.
+class FieldBatch {
+public:
+    FieldBatch(int rows, int cols) : layout(rows, cols), cells(static_cast<size_t>(rows) * cols) {}
+
+    void setOpen(int x, int y, bool open) { layout.setOpen(x, y, open); }
+
+    // out[s * rows * cols + cell]: moves from sources[s] to every cell, row-major, -1 where
+    // unreachable; each source counts as open in its own field
+    void distances(const vector<Point>& sources, vector<int>& out, TaskScheduler* scheduler = nullptr) const;
+
+private:
+    WavefrontField layout;  // Open cells only, copied by each block
+    size_t cells;
+};
+
 enum Turn {
     RIGHT_90 = 2,
     RIGHT_45 = 1,
@@ -35,19 +176,48 @@ enum Turn {
 };
 
 // Function declarations
-Turn rotation(array<int,2> currDir, array<int,2> newDir);
-int inverseMap(array<int, 2> d);
-int getRotation45(array<int, 2> from, array<int, 2> to);
+Turn rotation(Direction currDir, Direction newDir);
 array<int,2> directionBetweenPoints(Point &start, Point &end);
 
 bool isValid(int x, int y, const vector<vector<char>>& grid, const vector<vector<bool>>& visited, bool includeWalls);
+// Whether a path may enter a cell holding `cell`, as in isValid
+bool isPassable(char cell, bool includeWalls);
 Point wrapPoint(int x, int y, int rows, int cols);
 vector<Point> bfsPathfinder(const vector<vector<char>>& grid, Point start, Point end, bool includeWalls);
+// The same searches on the caller's scratch space, writing the path (empty if there is none) into
+// the caller's `path`; with both kept between calls a search allocates nothing. The one-call forms
+// use one context per thread.
+void bfsPathfinder(const vector<vector<char>>& grid, Point start, Point end, bool includeWalls,
+                   SearchContext& context, vector<Point>& path);
+vector<Point> aStarPathfinder(const vector<vector<char>>& grid, Point start, Point end, bool includeWalls, size_t* expanded = nullptr);
+void aStarPathfinder(const vector<vector<char>>& grid, Point start, Point end, bool includeWalls,
+                     SearchContext& context, vector<Point>& path, size_t* expanded = nullptr);
+vector<Point> bidirectionalPathfinder(const vector<vector<char>>& grid, Point start, Point end, bool includeWalls, size_t* expanded = nullptr);
+vector<Point> jumpPointPathfinder(const vector<vector<char>>& grid, Point start, Point end, bool includeWalls, size_t* expanded = nullptr);
+SearchStrategy chooseStrategy(int rows, int cols);
+FieldStrategy chooseFieldStrategy(int rows, int cols);
+// Path with the given strategy; like bfsPathfinder, retries through walls if there is no other way
+vector<Point> findPath(const vector<vector<char>>& grid, Point start, Point end, bool includeWalls,
+                       SearchStrategy strategy = SearchStrategy::Auto);
+// On the caller's scratch space, as above; the bidirectional and jump-point searches still use
+// buffers of their own
+void findPath(const vector<vector<char>>& grid, Point start, Point end, bool includeWalls,
+              SearchContext& context, vector<Point>& path, SearchStrategy strategy = SearchStrategy::Auto);
+// Moves from the nearest of `sources` to every cell over the cells bfsPathfinder enters (the
+// sources themselves always count), row-major, -1 where unreachable
+void distanceField(const vector<vector<char>>& grid, const vector<Point>& sources, bool includeWalls, vector<int>& out,
+                   FieldStrategy strategy = FieldStrategy::Auto);
+// One such field per source, all at once (see FieldBatch)
+void distanceFields(const vector<vector<char>>& grid, const vector<Point>& sources, bool includeWalls, vector<int>& out,
+                    TaskScheduler* scheduler = nullptr);
 int dist(Point p1, Point p2, int rows, int cols);
 int distArr(array<int,2> p1, array<int,2> p2, int rows, int cols);
-void updatePathEnd(vector<Point> &path, Point &newEnd, int rows, int cols);
-void updatePathStart(vector<Point> &path, Point &newStart, int rows, int cols);
+// Moves along a path whose steps may be more than one move apart (see HierarchicalPathFinder)
+int pathLength(const vector<Point>& path, int width, int height);
+// Slide a path's end (start) onto a cell next to it, trimming the steps the new one skips
+void updatePathEnd(deque<Point> &path, Point &newEnd, int rows, int cols);
+void updatePathStart(deque<Point> &path, Point &newStart, int rows, int cols);
 bool isPathStraight(vector<Point> &path, int rows, int columns);
-bool isPathClear(vector<Point> &path, const vector<vector<char>>& grid);
+bool isPathClear(vector<Point> &path, const BoardPlanes& planes);
 array<int,2> calcDirection(vector<Point> &path, int rows, int columns);
 void printPath(const vector<Point>& path);
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+#include <memory>
+#include <utility>
+
+#include "../UserCommon/SatelliteBattleInfo.h"
+#include "HierarchicalPathFinder.h"
+#include "MapAnalysis.h"
+#include "TargetAssignment.h"
+
+namespace Algorithm_208000547_208000547 {
+
+// The battle info this library's Player hands its tanks: the satellite view plus the player's
+// map analysis and, on big maps, its cluster graph, both shared by all of its tanks, and the
+// tank's part of this round's target assignment.
+class PlayerBattleInfo : public UserCommon_208000547_208000547::SatelliteBattleInfo {
+public:
+    PlayerBattleInfo(SatelliteView* view, int player_index) : SatelliteBattleInfo(view, player_index) {}
+
+    const std::shared_ptr<const MapAnalysis>& getMapAnalysis() const { return mapAnalysis; }
+    void setMapAnalysis(std::shared_ptr<const MapAnalysis> analysis) { mapAnalysis = std::move(analysis); }
+
+    // Null on boards small enough to search directly
+    const std::shared_ptr<const HierarchicalPathFinder>& getHierarchy() const { return hierarchy; }
+    void setHierarchy(std::shared_ptr<const HierarchicalPathFinder> pathFinder) { hierarchy = std::move(pathFinder); }
+
+    // Null if the tank has no target assigned; only valid during updateBattleInfo()
+    const TargetAssignment::Assignment* getAssignment() const { return assignment; }
+    void setAssignment(const TargetAssignment::Assignment* tankAssignment) { assignment = tankAssignment; }
+
+private:
+    std::shared_ptr<const MapAnalysis> mapAnalysis;
+    std::shared_ptr<const HierarchicalPathFinder> hierarchy;
+    const TargetAssignment::Assignment* assignment = nullptr;
+};
+
+} // namespace Algorithm_208000547_208000547
@@ -1,12 +1,42 @@
 #include "Player_208000547_208000547.h"
 #include "../common/PlayerRegistration.h"
-#include "../UserCommon/SatelliteBattleInfo.h"
+#include "PlayerBattleInfo.h"
 #include <iostream>
 
 using namespace UserCommon_208000547_208000547;
 
 namespace Algorithm_208000547_208000547{
-// Methods are already defined inline in the header file
+void Player_208000547_208000547::updateTankWithBattleInfo(TankAlgorithm& tank, SatelliteView& satellite_view) {
+    PlayerBattleInfo battle_info(&satellite_view, player_index);
+    battle_info.updateBoard();
+
+    // The first view is analysed once for all tanks, on the simulator's threads if it shares them;
+    // later views only record what has opened
+    if (!mapAnalysis) {
+        TaskScheduler* scheduler = sharedTaskScheduler ? sharedTaskScheduler() : nullptr;
+        mapAnalysis = std::make_shared<MapAnalysis>(battle_info.getBoard(), static_cast<int>(battle_info.getRows()),
+                                                    static_cast<int>(battle_info.getColumns()), scheduler);
+    } else {
+        mapAnalysis->refresh(battle_info.getBoard());
+    }
+    battle_info.setMapAnalysis(mapAnalysis);
+
+    // Big maps also get a cluster graph to plan on, repaired where the board has changed
+    if (hierarchy) {
+        hierarchy->update(battle_info.getBoard());
+    } else if (battle_info.getRows() * battle_info.getColumns() >= HierarchicalPathFinder::MIN_CELLS) {
+        hierarchy = std::make_shared<HierarchicalPathFinder>(battle_info.getBoard(), static_cast<int>(battle_info.getRows()),
+                                                             static_cast<int>(battle_info.getColumns()));
+    }
+    battle_info.setHierarchy(hierarchy);
+
+    // Spread all tanks over the enemies once per round, then hand this tank its part
+    const char ownTank = player_index == 1 ? PLAYER1_TANK : PLAYER2_TANK;
+    const char enemyTank = player_index == 1 ? PLAYER2_TANK : PLAYER1_TANK;
+    targets.update(battle_info.getBoard(), ownTank, enemyTank);
+    battle_info.setAssignment(targets.forTank(battle_info.getTankX(), battle_info.getTankY()));
+    tank.updateBattleInfo(battle_info);
+}
 } 
 
 using Player_208000547_208000547 = Algorithm_208000547_208000547::Player_208000547_208000547;
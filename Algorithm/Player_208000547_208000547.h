@@ -9,6 +9,9 @@
 #include "../common/TankAlgorithm.h"
 #include "../common/Player.h"
 #include "../UserCommon/SatelliteBattleInfo.h"
+#include "HierarchicalPathFinder.h"
+#include "MapAnalysis.h"
+#include "TargetAssignment.h"
 
 namespace Algorithm_208000547_208000547 {
     using namespace UserCommon_208000547_208000547;
@@ -20,16 +23,15 @@ namespace Algorithm_208000547_208000547 {
         size_t y;
         size_t max_steps;
         size_t num_shells;
+        std::shared_ptr<MapAnalysis> mapAnalysis;  // Built from the first view, shared by all tanks
+        std::shared_ptr<HierarchicalPathFinder> hierarchy;  // Likewise, on big maps only
+        TargetAssignment targets;  // Redone on the first view of each round
     public:
         Player_208000547_208000547(int player_index, size_t x, size_t y, size_t max_steps, size_t num_shells) 
             : player_index(player_index), x(x), y(y), max_steps(max_steps), num_shells(num_shells) {}
         
         void updateTankWithBattleInfo
-            (TankAlgorithm& tank, SatelliteView& satellite_view) override {
-            SatelliteBattleInfo battle_info(&satellite_view, player_index);
-            battle_info.updateBoard();
-            tank.updateBattleInfo(battle_info);
-        }
+            (TankAlgorithm& tank, SatelliteView& satellite_view) override;
     };
     
 }
\ No newline at end of file
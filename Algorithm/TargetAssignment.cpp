@@ -0,0 +1,156 @@
+#include "TargetAssignment.h"
+#include <algorithm>
+#include <utility>
+
+namespace Algorithm_208000547_208000547 {
+
+namespace {
+// Steps of each path entered in the reservation table
+constexpr int RESERVED_STEPS = 8;
+
+bool blocksWave(char cell) {
+    return cell == WALL || cell == DAMAGED_WALL || cell == MINE ||
+           cell == WALL_SHELL_COLLISION || cell == MINE_SHELL_COLLISION;
+}
+}
+
+void TargetAssignment::update(const vector<vector<char>>& board, char ownTank, char enemyTank) {
+    const int boardRows = static_cast<int>(board.size());
+    const int boardColumns = boardRows > 0 ? static_cast<int>(board[0].size()) : 0;
+    vector<char> current;
+    current.reserve(static_cast<size_t>(boardRows) * boardColumns);
+    for (const auto& row : board) {
+        for (char cell : row) {
+            current.push_back(cell == REQUESTING_TANK ? ownTank : cell);
+        }
+    }
+    if (boardRows == rows && boardColumns == columns && current == lastBoard) {
+        return;  // Another tank's view of a round already assigned
+    }
+    rows = boardRows;
+    columns = boardColumns;
+    lastBoard = std::move(current);
+    assignments.clear();
+    byCell.clear();
+    reserved.clear();
+
+    vector<size_t> tanks;
+    vector<size_t> enemies;
+    for (size_t cell = 0; cell < lastBoard.size(); ++cell) {
+        if (lastBoard[cell] == ownTank) {
+            tanks.push_back(cell);
+        } else if (lastBoard[cell] == enemyTank) {
+            enemies.push_back(cell);
+        }
+    }
+    if (tanks.empty() || enemies.empty()) {
+        return;
+    }
+
+    // Each enemy takes at most its share of the tanks
+    const int share = static_cast<int>((tanks.size() + enemies.size() - 1) / enemies.size());
+    vector<int> capacity(enemies.size(), share);
+
+    vector<std::pair<int32_t, size_t>> reached;  // (distance, tank cell)
+    while (!tanks.empty()) {
+        wave(enemies, capacity);
+
+        reached.clear();
+        for (size_t cell : tanks) {
+            if (distance[cell] >= 0) {
+                reached.emplace_back(distance[cell], cell);
+            }
+        }
+        if (reached.empty()) {
+            break;  // The rest cannot reach any enemy with room left
+        }
+        std::sort(reached.begin(), reached.end());
+
+        // Closest tanks bid first; a tank whose enemy filled up waits for the next wave
+        tanks.clear();
+        for (const auto& [d, cell] : reached) {
+            const int enemy = source[cell];
+            if (capacity[enemy] == 0) {
+                tanks.push_back(cell);
+                continue;
+            }
+            --capacity[enemy];
+            const size_t target = enemies[enemy];
+            byCell[cell] = assignments.size();
+            assignments.push_back({{static_cast<int>(target % columns), static_cast<int>(target / columns)}, pathDown(cell)});
+        }
+    }
+}
+
+void TargetAssignment::wave(const vector<size_t>& enemyCells, const vector<int>& capacity) {
+    distance.assign(lastBoard.size(), -1);
+    source.assign(lastBoard.size(), -1);
+    vector<size_t> queue;
+    for (size_t e = 0; e < enemyCells.size(); ++e) {
+        if (capacity[e] > 0) {
+            distance[enemyCells[e]] = 0;
+            source[enemyCells[e]] = static_cast<int32_t>(e);
+            queue.push_back(enemyCells[e]);
+        }
+    }
+    for (size_t head = 0; head < queue.size(); ++head) {
+        const size_t cell = queue[head];
+        const int x = static_cast<int>(cell % columns);
+        const int y = static_cast<int>(cell / columns);
+        for (int i = 0; i < 8; ++i) {
+            const Direction dir = Direction(Direction::Up).rotated(i);
+            const size_t next = index((x + dir.dx() + columns) % columns, (y + dir.dy() + rows) % rows);
+            if (distance[next] < 0 && !blocksWave(lastBoard[next])) {
+                distance[next] = distance[cell] + 1;
+                source[next] = source[cell];
+                queue.push_back(next);
+            }
+        }
+    }
+}
+
+vector<Point> TargetAssignment::pathDown(size_t from) {
+    const uint64_t cells = lastBoard.size();
+    vector<Point> path;
+    path.push_back({static_cast<int>(from % columns), static_cast<int>(from / columns)});
+    reserved.insert(from);
+
+    size_t cell = from;
+    for (int step = 1; distance[cell] > 0; ++step) {
+        // Any neighbour one step closer to the same enemy is on a shortest route; prefer one
+        // that no earlier tank has reserved for this step
+        const int x = static_cast<int>(cell % columns);
+        const int y = static_cast<int>(cell / columns);
+        size_t chosen = cell;
+        for (int i = 0; i < 8; ++i) {
+            const Direction dir = Direction(Direction::Up).rotated(i);
+            const size_t next = index((x + dir.dx() + columns) % columns, (y + dir.dy() + rows) % rows);
+            if (distance[next] != distance[cell] - 1 || source[next] != source[cell]) {
+                continue;
+            }
+            if (chosen == cell) {
+                chosen = next;
+            }
+            if (step > RESERVED_STEPS || reserved.count(step * cells + next) == 0) {
+                chosen = next;
+                break;
+            }
+        }
+        if (step <= RESERVED_STEPS) {
+            reserved.insert(step * cells + chosen);
+        }
+        cell = chosen;
+        path.push_back({static_cast<int>(cell % columns), static_cast<int>(cell / columns)});
+    }
+    return path;
+}
+
+const TargetAssignment::Assignment* TargetAssignment::forTank(int x, int y) const {
+    if (x < 0 || y < 0 || x >= columns || y >= rows) {
+        return nullptr;
+    }
+    const auto it = byCell.find(index(x, y));
+    return it == byCell.end() ? nullptr : &assignments[it->second];
+}
+
+} // namespace Algorithm_208000547_208000547
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "PathFinder.h"
+
+namespace Algorithm_208000547_208000547 {
+
+// Spreads a player's tanks over the enemy tanks. Run by the Player once per round, on the first
+// satellite view of the round, for all of its tanks on the board at once:
+//  - Targets are handed out by a greedy auction. Each enemy takes at most its share of the
+//    tanks. A breadth-first wave from all enemies that still have room finds every tank's
+//    nearest one, and the closest tanks get their targets first. Tanks whose enemy filled up
+//    wait for the next wave, so the cost is a few passes over the board, not one search per
+//    tank or enemy.
+//  - Each tank gets a shortest path down its wave to the target. The first steps of every path
+//    are reserved in a cell-and-time table, and later tanks prefer shortest routes whose cells
+//    are still free at that time. Tanks with different routes no longer block each other.
+// Walls, damaged walls and mines block the waves; tanks and shells do not. Tanks that no wave
+// reaches get no assignment and plan on their own.
+class TargetAssignment {
+public:
+    struct Assignment {
+        Point target;
+        vector<Point> path;  // From the tank's cell to the target, both included
+    };
+
+    // Assign targets to the tanks drawn as `ownTank` (and REQUESTING_TANK) on `board`, unless the
+    // board is the one already assigned for (the same round seen by another tank)
+    void update(const vector<vector<char>>& board, char ownTank, char enemyTank);
+
+    // The assignment of the tank at (x, y), or null if it has none
+    const Assignment* forTank(int x, int y) const;
+
+private:
+    int rows = 0;
+    int columns = 0;
+    vector<char> lastBoard;  // Row-major, with REQUESTING_TANK drawn as an own tank
+    vector<Assignment> assignments;
+    std::unordered_map<size_t, size_t> byCell;  // Tank cell -> index into assignments
+
+    // Per wave
+    vector<int32_t> distance;
+    vector<int32_t> source;  // Index of the nearest enemy
+    std::unordered_set<uint64_t> reserved;  // step * cells + cell
+
+    size_t index(int x, int y) const { return static_cast<size_t>(y) * columns + x; }
+    void wave(const vector<size_t>& enemyCells, const vector<int>& capacity);
+    vector<Point> pathDown(size_t from);
+};
+
+} // namespace Algorithm_208000547_208000547
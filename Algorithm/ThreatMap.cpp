@@ -0,0 +1,58 @@
+#include "ThreatMap.h"
+#include "LineOfFire.h"
+
+namespace Algorithm_208000547_208000547 {
+
+using UserCommon_208000547_208000547::Direction;
+
+void ThreatMap::build(const BoardPlanes& planes, int projectedRounds) {
+    const int newWidth = static_cast<int>(planes.getColumns());
+    const int newHeight = static_cast<int>(planes.getRows());
+    if (newWidth != width || newHeight != height) {
+        width = newWidth;
+        height = newHeight;
+        danger.assign(static_cast<size_t>(width) * height, 0);
+        marked.clear();
+    }
+    for (size_t cell : marked) {
+        danger[cell] = 0;
+    }
+    marked.clear();
+    rounds = projectedRounds < MAX_ROUNDS ? projectedRounds : MAX_ROUNDS;
+
+    planes.forEachCell(BoardPlanes::Shell, [&](size_t shellX, size_t shellY) {
+        for (int d = 0; d < 8; ++d) {
+            const Direction dir = Direction::fromIndex(d);
+            int x = static_cast<int>(shellX);
+            int y = static_cast<int>(shellY);
+            for (int step = 1; step <= 2 * rounds; ++step) {
+                x = (x + dir.dx() + width) % width;
+                y = (y + dir.dy() + height) % height;
+                const size_t cell = static_cast<size_t>(y) * width + x;
+                if (danger[cell] == 0) {
+                    marked.push_back(cell);
+                }
+                danger[cell] |= static_cast<uint16_t>(1u << ((step - 1) / 2));
+                if (planes.test(LineOfFire::STOPPING, static_cast<size_t>(x), static_cast<size_t>(y))) {
+                    break;
+                }
+            }
+        }
+    });
+}
+
+bool ThreatMap::isDangerous(int x, int y, int first, int last) const {
+    if (first < 1) {
+        first = 1;
+    }
+    if (last > rounds) {
+        last = rounds;
+    }
+    if (danger.empty() || first > last) {
+        return false;
+    }
+    const uint16_t window = static_cast<uint16_t>(((1u << (last - first + 1)) - 1) << (first - 1));
+    return (danger[static_cast<size_t>(y) * width + x] & window) != 0;
+}
+
+} // namespace Algorithm_208000547_208000547
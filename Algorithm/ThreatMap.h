@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../UserCommon/BoardPlanes.h"
+
+namespace Algorithm_208000547_208000547 {
+
+// Where the shells seen on the board may be during the coming rounds. The satellite view does
+// not show which way a shell flies, so every shell is projected along all 8 directions, 2 cells
+// per round as the engine moves shells twice a round, until a wall or a tank stops it. Each cell
+// a projection passes through (the stopping cell included) is marked dangerous for that round.
+// Round 1 is the round in which the board was seen. A build touches only the cells the
+// projections reach, so it costs time linear in the number of shells.
+class ThreatMap {
+public:
+    using BoardPlanes = UserCommon_208000547_208000547::BoardPlanes;
+
+    static constexpr int MAX_ROUNDS = 16;
+
+    // Project the shells of `planes` over rounds 1..rounds (at most MAX_ROUNDS)
+    void build(const BoardPlanes& planes, int rounds);
+
+    // Whether a shell may pass through (x, y) during any of rounds first..last
+    bool isDangerous(int x, int y, int first, int last) const;
+
+private:
+    int width = 0;
+    int height = 0;
+    int rounds = 0;
+    std::vector<uint16_t> danger;  // Per cell, bit r - 1 set if dangerous in round r
+    std::vector<size_t> marked;    // Cells with any bit set, cleared by the next build
+};
+
+} // namespace Algorithm_208000547_208000547
@@ -0,0 +1,64 @@
+#include "EngineOptions.h"
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+namespace GameManager_208000547_208000547 {
+
+namespace {
+    bool envEquals(const char* name, const std::string& value) {
+        const char* env = std::getenv(name);
+        return env && value == env;
+    }
+
+    size_t envCount(const char* name, size_t fallback) {
+        const char* env = std::getenv(name);
+        if (!env) {
+            return fallback;
+        }
+        try {
+            long value = std::stol(env);
+            return value > 0 ? static_cast<size_t>(value) : fallback;
+        } catch (const std::exception&) {
+            return fallback;
+        }
+    }
+}
+
+EngineOptions EngineOptions::fromEnvironment() {
+    EngineOptions options;
+    if (envEquals("TANKGAME_OUTPUT_FORMAT", "binary")) {
+        options.outputFormat = OutputWriter::Format::Binary;
+    }
+    options.recordReplay = envEquals("TANKGAME_RECORD_REPLAY", "1");
+    options.resumeFromSnapshots = envEquals("TANKGAME_RESUME_SNAPSHOTS", "1");
+    options.earlyTermination = envEquals("TANKGAME_EARLY_TERMINATION", "1");
+
+    options.snapshotInterval = envCount("TANKGAME_SNAPSHOT_INTERVAL", 0);
+    options.decisionThreads = envCount("TANKGAME_DECISION_THREADS", 1);
+    options.checkDeterminism = envEquals("TANKGAME_CHECK_DETERMINISM", "1");
+    // The sequential reference game always runs to the end, so the checked one must too
+    if (options.checkDeterminism) {
+        options.earlyTermination = false;
+    }
+
+    const char* threadSafe = std::getenv("TANKGAME_THREADSAFE_ALGORITHMS");
+    if (threadSafe) {
+        std::istringstream names(threadSafe);
+        std::string name;
+        while (std::getline(names, name, ',')) {
+            if (!name.empty()) {
+                options.threadSafeAlgorithms.push_back(name);
+            }
+        }
+    }
+    return options;
+}
+
+bool EngineOptions::isThreadSafe(const std::string& algorithmName) const {
+    return std::find(threadSafeAlgorithms.begin(), threadSafeAlgorithms.end(), algorithmName)
+        != threadSafeAlgorithms.end();
+}
+
+} // namespace GameManager_208000547_208000547
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "OutputWriter.h"
+
+namespace GameManager_208000547_208000547 {
+
+// Optional engine features. The GameManager interface is fixed by the course,
+// so these are read from the environment when a GameManager is created:
+//   TANKGAME_OUTPUT_FORMAT=binary      compact binary output log instead of text
+//   TANKGAME_RECORD_REPLAY=1           record replay_<gm>_<player1>_vs_<player2>_<map> (see ReplayLog.h)
+//   TANKGAME_SNAPSHOT_INTERVAL=<K>     write an engine snapshot every K rounds (see EngineSnapshot.h)
+//   TANKGAME_RESUME_SNAPSHOTS=1        resume a game from its snapshot file if one exists
+//   TANKGAME_EARLY_TERMINATION=1       end decided headless games early (see GameManager::checkDecidedOutcome)
+//   TANKGAME_DECISION_THREADS=<N>      collect the tanks' getAction() results on N threads
+//   TANKGAME_THREADSAFE_ALGORITHMS=<a,b,...>
+//                                      algorithms declared safe for that; both players' must be listed
+//   TANKGAME_CHECK_DETERMINISM=1       the simulator replays each game sequentially and compares the
+//                                      results; early termination is then off
+struct EngineOptions {
+    OutputWriter::Format outputFormat = OutputWriter::Format::Text;
+    bool recordReplay = false;
+    size_t snapshotInterval = 0;  // 0 disables snapshots
+    bool resumeFromSnapshots = false;
+    bool earlyTermination = false;  // Only applies to headless games without a replay stream
+    size_t decisionThreads = 1;  // 1 keeps the decision phase on the game's own thread
+    std::vector<std::string> threadSafeAlgorithms;
+    bool checkDeterminism = false;  // Only turns early termination off; the simulator does the check
+
+    bool isThreadSafe(const std::string& algorithmName) const;
+
+    static EngineOptions fromEnvironment();
+};
+
+} // namespace GameManager_208000547_208000547
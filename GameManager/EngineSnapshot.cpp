@@ -0,0 +1,177 @@
+#include "EngineSnapshot.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace GameManager_208000547_208000547 {
+
+namespace {
+    const char SNAPSHOT_MAGIC[4] = {'T', 'G', 'S', '2'};
+    const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+    const uint64_t FNV_PRIME = 1099511628211ULL;
+
+    void appendUint(std::string& out, uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+        }
+    }
+
+    // Sequential reader over an in-memory snapshot
+    class SnapshotReader {
+    private:
+        const std::string& data;
+        const std::string& fileName;
+        size_t pos;
+    public:
+        SnapshotReader(const std::string& data, const std::string& fileName) : data(data), fileName(fileName), pos(0) {}
+
+        uint64_t readUint(int bytes) {
+            if (pos + static_cast<size_t>(bytes) > data.size()) {
+                throw std::runtime_error("Truncated snapshot: " + fileName);
+            }
+            uint64_t value = 0;
+            for (int i = 0; i < bytes; ++i) {
+                value |= static_cast<uint64_t>(static_cast<unsigned char>(data[pos++])) << (8 * i);
+            }
+            return value;
+        }
+
+        int8_t readInt8() { return static_cast<int8_t>(readUint(1)); }
+        int32_t readInt32() { return static_cast<int32_t>(static_cast<uint32_t>(readUint(4))); }
+
+        void readBytes(char* dest, size_t count) {
+            if (pos + count > data.size()) {
+                throw std::runtime_error("Truncated snapshot: " + fileName);
+            }
+            std::copy(data.begin() + pos, data.begin() + pos + count, dest);
+            pos += count;
+        }
+    };
+}
+
+void EngineSnapshot::writeToFile(const std::string& fileName) const {
+    std::string out;
+    out.reserve(64 + rows * columns + tanks.size() * 24 + shells.size() * 10);
+    out.append(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    appendUint(out, mapHash, 8);
+    appendUint(out, maxSteps, 4);
+    appendUint(out, numShells, 4);
+    appendUint(out, outputBytes, 8);
+    appendUint(out, round, 4);
+    appendUint(out, columns, 4);
+    appendUint(out, rows, 4);
+    appendUint(out, player1TankCount, 4);
+    appendUint(out, player2TankCount, 4);
+    appendUint(out, allTanksOutOfShells ? 1 : 0, 1);
+    appendUint(out, static_cast<uint32_t>(roundsSinceNoShells), 4);
+    for (size_t y = 0; y < rows; ++y) {
+        out.append(board[y].data(), columns);
+    }
+
+    appendUint(out, tanks.size(), 4);
+    for (const auto& tank : tanks) {
+        appendUint(out, tank.x, 4);
+        appendUint(out, tank.y, 4);
+        appendUint(out, static_cast<uint8_t>(tank.dx), 1);
+        appendUint(out, static_cast<uint8_t>(tank.dy), 1);
+        appendUint(out, static_cast<uint8_t>(tank.playerId), 1);
+        appendUint(out, (tank.isAlive ? 1 : 0) | (tank.isMovingBackward ? 2 : 0), 1);
+        appendUint(out, static_cast<uint32_t>(tank.backwardMoveCounter), 4);
+        appendUint(out, static_cast<uint32_t>(tank.shootCooldown), 4);
+        appendUint(out, static_cast<uint32_t>(tank.numShells), 4);
+    }
+
+    appendUint(out, shells.size(), 4);
+    for (const auto& shell : shells) {
+        appendUint(out, shell.x, 4);
+        appendUint(out, shell.y, 4);
+        appendUint(out, static_cast<uint8_t>(shell.dx), 1);
+        appendUint(out, static_cast<uint8_t>(shell.dy), 1);
+    }
+
+    std::string tempName = fileName + ".tmp";
+    {
+        std::ofstream file(tempName, std::ios::out | std::ios::trunc | std::ios::binary);
+        if (!file.is_open() || !file.write(out.data(), static_cast<std::streamsize>(out.size()))) {
+            throw std::runtime_error("Could not write snapshot: " + tempName);
+        }
+    }
+    std::filesystem::rename(tempName, fileName);
+}
+
+EngineSnapshot EngineSnapshot::readFromFile(const std::string& fileName) {
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open snapshot: " + fileName);
+    }
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    SnapshotReader in(data, fileName);
+    char magic[4];
+    in.readBytes(magic, sizeof(magic));
+    if (!std::equal(magic, magic + 4, SNAPSHOT_MAGIC)) {
+        throw std::runtime_error("Not an engine snapshot: " + fileName);
+    }
+
+    EngineSnapshot snapshot;
+    snapshot.mapHash = in.readUint(8);
+    snapshot.maxSteps = in.readUint(4);
+    snapshot.numShells = in.readUint(4);
+    snapshot.outputBytes = in.readUint(8);
+    snapshot.round = in.readUint(4);
+    snapshot.columns = in.readUint(4);
+    snapshot.rows = in.readUint(4);
+    snapshot.player1TankCount = in.readUint(4);
+    snapshot.player2TankCount = in.readUint(4);
+    snapshot.allTanksOutOfShells = in.readUint(1) != 0;
+    snapshot.roundsSinceNoShells = in.readInt32();
+    snapshot.board.assign(snapshot.rows, UserCommon_208000547_208000547::BoardRow(snapshot.columns));
+    for (size_t y = 0; y < snapshot.rows; ++y) {
+        in.readBytes(snapshot.board[y].data(), snapshot.columns);
+    }
+
+    snapshot.tanks.resize(in.readUint(4));
+    for (auto& tank : snapshot.tanks) {
+        tank.x = static_cast<uint32_t>(in.readUint(4));
+        tank.y = static_cast<uint32_t>(in.readUint(4));
+        tank.dx = in.readInt8();
+        tank.dy = in.readInt8();
+        tank.playerId = in.readInt8();
+        uint64_t flags = in.readUint(1);
+        tank.isAlive = (flags & 1) != 0;
+        tank.isMovingBackward = (flags & 2) != 0;
+        tank.backwardMoveCounter = in.readInt32();
+        tank.shootCooldown = in.readInt32();
+        tank.numShells = in.readInt32();
+    }
+
+    snapshot.shells.resize(in.readUint(4));
+    for (auto& shell : snapshot.shells) {
+        shell.x = static_cast<uint32_t>(in.readUint(4));
+        shell.y = static_cast<uint32_t>(in.readUint(4));
+        shell.dx = in.readInt8();
+        shell.dy = in.readInt8();
+    }
+    return snapshot;
+}
+
+uint64_t EngineSnapshot::hashMap(const UserCommon_208000547_208000547::BoardGrid& board) {
+    // FNV-1a over the cells, with the dimensions first so that reshaped boards differ
+    uint64_t hash = FNV_OFFSET;
+    auto mix = [&hash](uint64_t value) {
+        hash ^= value;
+        hash *= FNV_PRIME;
+    };
+    mix(board.size());
+    mix(board.empty() ? 0 : board[0].size());
+    for (const auto& row : board) {
+        for (char cell : row) {
+            mix(static_cast<unsigned char>(cell));
+        }
+    }
+    return hash;
+}
+
+} // namespace GameManager_208000547_208000547
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../UserCommon/GameArena.h"
+
+namespace GameManager_208000547_208000547 {
+
+struct TankSnapshot {
+    uint32_t x, y;
+    int8_t dx, dy;
+    int8_t playerId;
+    bool isAlive;
+    bool isMovingBackward;
+    int32_t backwardMoveCounter;
+    int32_t shootCooldown;
+    int32_t numShells;
+};
+
+struct ShellSnapshot {
+    uint32_t x, y;
+    int8_t dx, dy;
+};
+
+// Full engine state at the end of a round, enough to continue the game from the next round.
+// Algorithm state is opaque to the engine and is not part of a snapshot.
+//
+// File layout (all integers little-endian):
+//   "TGS2", uint64 map hash, uint32 max steps, shells per tank, uint64 output file bytes,
+//   uint32 round, columns, rows, player 1 tanks, player 2 tanks,
+//   uint8 all-tanks-out-of-shells flag, uint32 rounds since no shells,
+//   rows * columns board bytes,
+//   uint32 number of tanks, then per tank (creation order): uint32 x, y, int8 dx, dy, player,
+//       uint8 flags (bit 0 alive, bit 1 moving backward), int32 backward counter, cooldown, shells
+//   uint32 number of shells, then per shell: uint32 x, y, int8 dx, dy
+struct EngineSnapshot {
+    // The game the snapshot belongs to; a snapshot only resumes the same map and settings
+    uint64_t mapHash = 0;  // hashMap() of the initial board
+    size_t maxSteps = 0;
+    size_t numShells = 0;
+    uint64_t outputBytes = 0;  // Length of the output file up to this round, 0 if there was none
+
+    size_t round = 0;  // Rounds completed when the snapshot was taken
+    size_t columns = 0;
+    size_t rows = 0;
+    size_t player1TankCount = 0;
+    size_t player2TankCount = 0;
+    bool allTanksOutOfShells = false;
+    int roundsSinceNoShells = 0;
+    UserCommon_208000547_208000547::BoardGrid board;
+    std::vector<TankSnapshot> tanks;  // Indexed by creation order
+    std::vector<ShellSnapshot> shells;
+
+    // Writes to a temporary file first so a crash never leaves a partial snapshot behind.
+    // Throws std::runtime_error on I/O failure.
+    void writeToFile(const std::string& fileName) const;
+
+    // Throws std::runtime_error if the file cannot be read or is malformed
+    static EngineSnapshot readFromFile(const std::string& fileName);
+
+    static uint64_t hashMap(const UserCommon_208000547_208000547::BoardGrid& board);
+};
+
+} // namespace GameManager_208000547_208000547
@@ -1,29 +1,231 @@
 #include "GameManager.h"
+#include "ReachabilityAnalysis.h"
 #include "../UserCommon/GameSatelliteView.h"
 #include <algorithm>
 #include <set>
 #include <memory>
 #include <filesystem>
+#include <fstream>
+#include <dlfcn.h>
 #include "../common/GameManagerRegistration.h"
 
 using namespace std;
 using namespace UserCommon_208000547_208000547;
 namespace GameManager_208000547_208000547 {
 
+namespace {
+    const char libraryAnchor = 0;
+
+    // Name of the shared library (or tool) this engine was loaded from. A comparative run loads
+    // several GameManagers that may all be builds of this one, so files they keep per game are
+    // told apart by it.
+    const string& engineName() {
+        static const string name = [] {
+            Dl_info info;
+            if (dladdr(&libraryAnchor, &info) != 0 && info.dli_fname) {
+                return std::filesystem::path(info.dli_fname).stem().string();
+            }
+            return string("GameManager_208000547_208000547");
+        }();
+        return name;
+    }
+
+    // <prefix>_<engine>_<name1>_vs_<name2>_<map file> next to the map file. Several games can
+    // share a map, so files kept per game are keyed by the GameManager and both players too.
+    std::filesystem::path gameFilePath(const string& prefix, const string& inputFileName,
+                                       const string& name1, const string& name2) {
+        std::filesystem::path inputPath(inputFileName);
+        return inputPath.parent_path() /
+            (prefix + "_" + engineName() + "_" + name1 + "_vs_" + name2 + "_" + inputPath.filename().string());
+    }
+}
+
 GameManager::GameManager(bool verbose) : 
-    creationOrderCounter(0),
+    gameData(arena.resource()),
+    boardPlanes(arena.resource()),
     verbose_(verbose),
+    options_(EngineOptions::fromEnvironment()),
+    decidedActions(arena.resource()),
+    tankTable(arena.resource()),
+    player1Tanks(arena.resource()),
+    player2Tanks(arena.resource()),
+    activeShells(arena.resource()),
+    roundStartBoard(arena.resource()),
     allTanksOutOfShells(false),
-    roundsSinceNoShells(0)
+    roundsSinceNoShells(0),
+    skippedRounds(0)
 {}
 
-void GameManager::setOutputFile(string inputFileName) {
+void GameManager::setReplayFile(const string& inputFileName, const string& name1, const string& name2) {
+    // Replay streams are recorded in any output mode
+    replayRecorder.reset();
+    if (options_.recordReplay) {
+        replayRecorder = make_unique<ReplayRecorder>(gameFilePath("replay", inputFileName, name1, name2).string());
+    }
+}
+
+void GameManager::setEarlyEndFile(const string& inputFileName, const string& name1, const string& name2) {
+    // A game that is played to the end this time must not leave an older run's log behind
+    earlyEndFileName = gameFilePath("early_end", inputFileName, name1, name2).string();
+    std::error_code error;
+    std::filesystem::remove(earlyEndFileName, error);
+}
+
+void GameManager::setOutputFile(string inputFileName, uint64_t resumeBytes) {
+    std::filesystem::path inputPath(inputFileName);
+
+    // Headless mode: no writer is created, so no per-round history is ever recorded
+    if (!verbose_) {
+        outputWriter.reset();
+        return;
+    }
+
     // Create output filename based on input filename
     // Create output file in the same directory as the input file
-    std::filesystem::path inputPath(inputFileName);
     std::filesystem::path outputPath = inputPath.parent_path() / ("output_" + inputPath.filename().string());
+
+    // The compact binary log gets its own extension (see OutputWriter::convertBinaryToText)
+    if (options_.outputFormat == OutputWriter::Format::Binary) {
+        outputPath.replace_extension(".bin");
+    }
+
     string outputFileName = outputPath.string();
-    outputWriter = make_unique<OutputWriter>(outputFileName, verbose_);
+    if (resumeBytes > 0) {
+        try {
+            outputWriter = make_unique<OutputWriter>(outputFileName, options_.outputFormat, resumeBytes);
+            return;
+        } catch (const std::exception& e) {
+            std::cerr << "Starting a new output file: " << e.what() << std::endl;
+        }
+    }
+    outputWriter = make_unique<OutputWriter>(outputFileName, options_.outputFormat);
+}
+
+void GameManager::setSnapshotFile(const string& inputFileName, const string& name1, const string& name2) {
+    snapshotFileName.clear();
+    if (options_.snapshotInterval == 0 && !options_.resumeFromSnapshots) {
+        return;
+    }
+
+    std::filesystem::path snapshotPath = gameFilePath("snapshot", inputFileName, name1, name2);
+    snapshotFileName = snapshotPath.string();
+
+    if (options_.resumeFromSnapshots && !pendingResume && std::filesystem::exists(snapshotPath)) {
+        try {
+            EngineSnapshot snapshot = EngineSnapshot::readFromFile(snapshotFileName);
+            // The map file may have been edited since, or the game started with other settings
+            if (snapshot.mapHash != initialMapHash || snapshot.maxSteps != gameData.maxStep ||
+                snapshot.numShells != gameData.numShells) {
+                std::cerr << "Ignoring snapshot of a different game: " << snapshotFileName << std::endl;
+                return;
+            }
+            pendingResume = make_unique<EngineSnapshot>(std::move(snapshot));
+            std::cout << "Resuming from snapshot " << snapshotFileName << " at round " << pendingResume->round << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << "Ignoring unreadable snapshot: " << e.what() << std::endl;
+        }
+    }
+}
+
+EngineSnapshot GameManager::captureSnapshot(size_t round) const {
+    EngineSnapshot snapshot;
+    snapshot.mapHash = initialMapHash;
+    snapshot.maxSteps = gameData.maxStep;
+    snapshot.numShells = gameData.numShells;
+    snapshot.round = round;
+    snapshot.columns = gameData.columns;
+    snapshot.rows = gameData.rows;
+    snapshot.player1TankCount = gameData.player1TankCount;
+    snapshot.player2TankCount = gameData.player2TankCount;
+    snapshot.allTanksOutOfShells = allTanksOutOfShells;
+    snapshot.roundsSinceNoShells = roundsSinceNoShells;
+    snapshot.board = gameData.board;
+
+    snapshot.tanks.resize(player1Tanks.size() + player2Tanks.size());
+    for (const auto* tanks : {&player1Tanks, &player2Tanks}) {
+        for (const auto& tank : *tanks) {
+            TankSnapshot& t = snapshot.tanks[static_cast<size_t>(tank.getCreationOrder())];
+            t.x = static_cast<uint32_t>(tank.getX());
+            t.y = static_cast<uint32_t>(tank.getY());
+            t.dx = static_cast<int8_t>(tank.getDirection().dx());
+            t.dy = static_cast<int8_t>(tank.getDirection().dy());
+            t.playerId = static_cast<int8_t>(tank.getPlayerId());
+            t.isAlive = tank.getIsAlive();
+            t.isMovingBackward = tank.getIsMovingBackward();
+            t.backwardMoveCounter = tank.getBackwardMoveCounter();
+            t.shootCooldown = tank.getShootCooldown();
+            t.numShells = tank.getNumShells();
+        }
+    }
+
+    snapshot.shells.reserve(activeShells.size());
+    for (const auto& shell : activeShells) {
+        snapshot.shells.push_back({static_cast<uint32_t>(shell.getX()), static_cast<uint32_t>(shell.getY()),
+                                   static_cast<int8_t>(shell.getDirection().dx()), static_cast<int8_t>(shell.getDirection().dy())});
+    }
+    return snapshot;
+}
+
+void GameManager::writeSnapshot(size_t round) {
+    try {
+        EngineSnapshot snapshot = captureSnapshot(round);
+        // The output file must hold this round before a snapshot can point past it
+        if (outputWriter) {
+            outputWriter->flush();
+            snapshot.outputBytes = outputWriter->getBytesOnDisk();
+        }
+        snapshot.writeToFile(snapshotFileName);
+        std::cout << "Wrote snapshot for round " << round << " to " << snapshotFileName << std::endl;
+    } catch (const std::exception& e) {
+        // A failed snapshot must not end the game
+        std::cerr << "Failed to write snapshot: " << e.what() << std::endl;
+    }
+}
+
+void GameManager::removeSnapshot() {
+    // A recorded replay keeps its snapshot so the replay tool can start from it
+    if (snapshotFileName.empty() || replayRecorder) {
+        return;
+    }
+    // The result must be on disk first, or a crash now would leave neither
+    if (outputWriter) {
+        outputWriter->flush();
+    }
+    std::error_code error;
+    std::filesystem::remove(snapshotFileName, error);
+}
+
+void GameManager::applySnapshot(const EngineSnapshot& snapshot) {
+    // Max steps are not compared: a replay may stop a resumed game early (see ReplayEngine)
+    if (snapshot.mapHash != initialMapHash || snapshot.numShells != gameData.numShells ||
+        snapshot.columns != gameData.columns || snapshot.rows != gameData.rows ||
+        snapshot.tanks.size() != player1Tanks.size() + player2Tanks.size()) {
+        throw std::runtime_error("Snapshot does not match this game's map");
+    }
+
+    gameData.board = snapshot.board;
+    boardPlanes.rebuild(gameData.board, gameData.rows, gameData.columns);
+    gameData.player1TankCount = snapshot.player1TankCount;
+    gameData.player2TankCount = snapshot.player2TankCount;
+    allTanksOutOfShells = snapshot.allTanksOutOfShells;
+    roundsSinceNoShells = snapshot.roundsSinceNoShells;
+
+    for (auto* tanks : {&player1Tanks, &player2Tanks}) {
+        for (auto& tank : *tanks) {
+            const TankSnapshot& t = snapshot.tanks[static_cast<size_t>(tank.getCreationOrder())];
+            if (t.playerId != tank.getPlayerId()) {
+                throw std::runtime_error("Snapshot does not match this game's tanks");
+            }
+            tank.setPosition(t.x, t.y);
+            tank.setDirection(t.dx, t.dy);
+            tank.restoreState(t.isAlive, t.shootCooldown, t.isMovingBackward, t.backwardMoveCounter, t.numShells);
+        }
+    }
+
+    activeShells.clear();
+    for (const auto& shell : snapshot.shells) {
+        activeShells.emplace_back(shell.x, shell.y, shell.dx, shell.dy, gameData.columns, gameData.rows);
+    }
 }
 
 
@@ -44,6 +246,43 @@ bool GameManager::checkAllTanksOutOfShells() {
     return true;
 }
 
+bool GameManager::checkDecidedOutcome(size_t completedRounds) {
+    // Only a shell can break a wall or hit a tank from afar, so with none left the board is
+    // static apart from tank movement; tanks can then only die on mines or by meeting each other
+    if (!allTanksOutOfShells || !activeShells.empty()) {
+        return false;
+    }
+
+    size_t zeroShellsRound = completedRounds + static_cast<size_t>(OutputWriter::ZERO_SHELLS_STEPS - roundsSinceNoShells);
+    size_t finalRound = std::min(zeroShellsRound, gameData.maxStep);
+    vector<pair<size_t, size_t>> tankPositions;
+    for (const auto* tanks : {&player1Tanks, &player2Tanks}) {
+        for (const auto& tank : *tanks) {
+            if (tank.getIsAlive()) {
+                tankPositions.emplace_back(tank.getX(), tank.getY());
+            }
+        }
+    }
+    if (canAnyTankBeDestroyed(gameData.board, tankPositions, finalRound - completedRounds)) {
+        return false;
+    }
+
+    // Tank counts are fixed from here, so only the round and reason of the end remain
+    skippedRounds = finalRound - completedRounds;
+    gameResult.rounds = finalRound;
+    std::cout << "Outcome decided after round " << completedRounds << ", skipping "
+              << skippedRounds << " rounds" << std::endl;
+    std::ofstream earlyEndLog(earlyEndFileName);
+    earlyEndLog << "Outcome decided after round " << completedRounds << ", skipped " << skippedRounds
+                << " rounds; the final board is the one after round " << completedRounds << std::endl;
+    if (finalRound == zeroShellsRound) {
+        updateGameResultReason(GameResult::ZERO_SHELLS);
+    } else {
+        updateGameResultReason(GameResult::MAX_STEPS);
+    }
+    return true;
+}
+
 bool GameManager::checkImmediateGameEnd() {
     std::cout << "Checking immediate game end conditions:" << std::endl;
     std::cout << "Player 1 tanks: " << gameData.player1TankCount << std::endl;
@@ -65,7 +304,7 @@ bool GameManager::checkImmediateGameEnd() {
         if (roundsSinceNoShells >= 40) { // ZERO_SHELLS_STEPS constant
             std::cout << "Game end: 40 rounds have passed since all tanks ran out of shells" << std::endl;
             updateGameResultReason(GameResult::ZERO_SHELLS);
-            outputWriter->writeZeroShellsTie();
+            if (outputWriter) outputWriter->writeZeroShellsTie();
             return true;
         }
     }
@@ -73,17 +312,17 @@ bool GameManager::checkImmediateGameEnd() {
     if (gameData.player1TankCount == 0 && gameData.player2TankCount == 0) {
         std::cout << "Game end: Both players have no tanks remaining - Tie" << std::endl;
         updateGameResultReason(GameResult::ALL_TANKS_DEAD);
-        outputWriter->writeGameEnd(0, 0);
+        if (outputWriter) outputWriter->writeGameEnd(0, 0);
         return true;
     } else if (gameData.player1TankCount == 0) {
         std::cout << "Game end: Player 1 has no tanks remaining - Player 2 wins" << std::endl;
         updateGameResultReason(GameResult::ALL_TANKS_DEAD);
-        outputWriter->writeGameEnd(2, gameData.player2TankCount);
+        if (outputWriter) outputWriter->writeGameEnd(2, gameData.player2TankCount);
         return true;
     } else if (gameData.player2TankCount == 0) {
         std::cout << "Game end: Player 2 has no tanks remaining - Player 1 wins" << std::endl;
         updateGameResultReason(GameResult::ALL_TANKS_DEAD);
-        outputWriter->writeGameEnd(1, gameData.player1TankCount);
+        if (outputWriter) outputWriter->writeGameEnd(1, gameData.player1TankCount);
         return true;
     }
     
@@ -91,8 +330,9 @@ bool GameManager::checkImmediateGameEnd() {
     return false;
 }
 
-vector<TankPosition> GameManager::collectTankPositions() {
-    vector<TankPosition> tankPositions;
+std::pmr::vector<TankPosition> GameManager::collectTankPositions() {
+    std::pmr::vector<TankPosition> tankPositions(arena.resource());
+    tankPositions.reserve(gameData.player1TankCount + gameData.player2TankCount);
     
     // Collect player 1 tank positions
     int tankIndex1 = 0;
@@ -117,7 +357,7 @@ vector<TankPosition> GameManager::collectTankPositions() {
     return tankPositions;
 }
 
-void GameManager::sortTankPositions(vector<TankPosition>& positions) {
+void GameManager::sortTankPositions(std::pmr::vector<TankPosition>& positions) {
     sort(positions.begin(), positions.end(), 
         [](const TankPosition& a, const TankPosition& b) {
             if (a.y != b.y) return a.y < b.y;
@@ -125,23 +365,29 @@ void GameManager::sortTankPositions(vector<TankPosition>& positions) {
         });
 }
 
-void GameManager::createTanksFromPositions(const vector<TankPosition>& positions, 
+void GameManager::createTanksFromPositions(const std::pmr::vector<TankPosition>& positions, 
                                          TankAlgorithmFactory& player1_factory, 
                                          TankAlgorithmFactory& player2_factory) {
+    // Size the table and both vectors up front so no TankInfo is moved while tanks are added
+    size_t player1Count = static_cast<size_t>(std::count_if(positions.begin(), positions.end(),
+        [](const TankPosition& pos) { return pos.playerId == 1; }));
+    tankTable.reset(gameData.columns, gameData.rows, positions.size());
+    player1Tanks.reserve(player1Count);
+    player2Tanks.reserve(positions.size() - player1Count);
+
     for (const auto& pos : positions) {
-        int dx = (pos.playerId == 1) ? -1 : 1;  // Player 1 faces left (-1,0), Player 2 faces right (1,0)
-        int dy = 0;  // Both players start with horizontal direction
+        // Player 1 faces left, Player 2 faces right
+        Direction facing = (pos.playerId == 1) ? Direction::Left : Direction::Right;
         
         TankAlgorithmFactory& factory = (pos.playerId == 1) ? player1_factory : player2_factory;
         auto algorithm = factory(pos.playerId, pos.tankIndex);
         
-        if (pos.playerId == 1) {
-            player1Tanks.emplace_back(pos.x, pos.y, dx, dy, std::move(algorithm), 
-                                    gameData.columns, gameData.rows, pos.playerId, creationOrderCounter++, gameData.numShells);
-        } else {
-            player2Tanks.emplace_back(pos.x, pos.y, dx, dy, std::move(algorithm), 
-                                    gameData.columns, gameData.rows, pos.playerId, creationOrderCounter++, gameData.numShells);
-        }
+        // Tanks are added in creation order, so a tank's row in the table is its creation order
+        size_t index = tankTable.add(pos.x, pos.y, facing, pos.playerId,
+                                     static_cast<int>(gameData.numShells), std::move(algorithm));
+        std::cout << "Tank " << index << " has " << gameData.numShells << " shells" << std::endl;
+        auto& tanks = (pos.playerId == 1) ? player1Tanks : player2Tanks;
+        tanks.emplace_back(tankTable, index);
     }
 }
 
@@ -156,9 +402,6 @@ void GameManager::initializePlayersAndTanks(Player& player1, Player& player2,
     playerOne = &player1;
     playerTwo = &player2;
     
-    // Reset creation order counter
-    creationOrderCounter = 0;
-    
     // Collect and sort tank positions
     auto tankPositions = collectTankPositions();
     sortTankPositions(tankPositions);
@@ -167,7 +410,7 @@ void GameManager::initializePlayersAndTanks(Player& player1, Player& player2,
     createTanksFromPositions(tankPositions, player1_factory, player2_factory);
 }
 
-void GameManager::detectShellCrossings(vector<bool>& shellsToRemove, map<pair<size_t, size_t>, vector<size_t>>& nextPositions) {
+void GameManager::detectShellCrossings(std::pmr::vector<bool>& shellsToRemove, ShellTargets& nextPositions) {
     // First pass: collect all potential moves and detect crossings
     for (size_t i = 0; i < activeShells.size(); i++) {
         auto nextPos = activeShells[i].getPotentialMove();
@@ -201,7 +444,7 @@ void GameManager::detectShellCrossings(vector<bool>& shellsToRemove, map<pair<si
     }
 }
 
-void GameManager::removeMarkedShells(const vector<bool>& shellsToRemove) {
+void GameManager::removeMarkedShells(const std::pmr::vector<bool>& shellsToRemove) {
     // Remove shells that are crossing
     for (int i = activeShells.size() - 1; i >= 0; i--) {
         if (shellsToRemove[i]) {
@@ -229,26 +472,31 @@ void GameManager::findAndKillTank(size_t x, size_t y) {
     }
 }
 
+void GameManager::setCell(size_t x, size_t y, char cell) {
+    gameData.board[y][x] = cell;
+    boardPlanes.setCell(x, y, cell);
+}
+
 void GameManager::handleTankCollision(const pair<size_t, size_t>& pos) {
     // Kill the tank
     findAndKillTank(pos.first, pos.second);
     
     // Mark position as empty
-    gameData.board[pos.second][pos.first] = EMPTY_SPACE;
+    setCell(pos.first, pos.second, EMPTY_SPACE);
 }
 
 void GameManager::handleWallCollision(const pair<size_t, size_t>& pos) {
     // we their is only one shell, so we can just destroy the wall
-    gameData.board[pos.second][pos.first] = DAMAGED_WALL;
+    setCell(pos.first, pos.second, DAMAGED_WALL);
 }
 
 void GameManager::handleDamagedWallCollision(const pair<size_t, size_t>& pos) {
     // Any number of shells destroys a damaged wall
-    gameData.board[pos.second][pos.first] = EMPTY_SPACE;
+    setCell(pos.first, pos.second, EMPTY_SPACE);
 }
 
 void GameManager::handleMineCollision(const pair<size_t, size_t>& pos) {
-    gameData.board[pos.second][pos.first] = MINE_SHELL_COLLISION;
+    setCell(pos.first, pos.second, MINE_SHELL_COLLISION);
 }
 
 void GameManager::handleMultipleShellCollision(const pair<size_t, size_t>& pos) {
@@ -271,11 +519,11 @@ void GameManager::handleMultipleShellCollision(const pair<size_t, size_t>& pos)
     }
     
     // Multiple shells destroy everything
-    gameData.board[pos.second][pos.first] = EMPTY_SPACE;
+    setCell(pos.first, pos.second, EMPTY_SPACE);
 }
 
-std::vector<std::pair<size_t, size_t>> GameManager::handleShellPositions(const map<pair<size_t, size_t>, vector<size_t>>& nextPositions) {
-    std::vector<std::pair<size_t, size_t>> collisionPositions;
+std::pmr::vector<std::pair<size_t, size_t>> GameManager::handleShellPositions(const ShellTargets& nextPositions) {
+    std::pmr::vector<std::pair<size_t, size_t>> collisionPositions(arena.resource());
     for (const auto& [pos, shellIndices] : nextPositions) {
         if (shellIndices.size() > 1) {
             // Multiple shells in same position - destroy everything
@@ -304,7 +552,7 @@ std::vector<std::pair<size_t, size_t>> GameManager::handleShellPositions(const m
                 handleMineCollision(pos);
                 break;
             case EMPTY_SPACE:
-                gameData.board[pos.second][pos.first] = SHELL;
+                setCell(pos.first, pos.second, SHELL);
                 break;
         }
     }
@@ -312,8 +560,8 @@ std::vector<std::pair<size_t, size_t>> GameManager::handleShellPositions(const m
 }
 
 void GameManager::moveShells() {
-    vector<bool> shellsToRemove(activeShells.size(), false);
-    map<pair<size_t, size_t>, vector<size_t>> nextPositions;  // Map of position to shell indices
+    std::pmr::vector<bool> shellsToRemove(activeShells.size(), false, arena.resource());
+    ShellTargets nextPositions(arena.resource());  // Map of position to shell indices
     
     // Detect crossings and collect next positions
     detectShellCrossings(shellsToRemove, nextPositions);
@@ -322,9 +570,9 @@ void GameManager::moveShells() {
     for (const auto& shell : activeShells) {
         char currentCell = gameData.board[shell.getY()][shell.getX()];
         if (currentCell == SHELL) {  // Only clear if it's a shell (not a tank)
-            gameData.board[shell.getY()][shell.getX()] = EMPTY_SPACE;
+            setCell(shell.getX(), shell.getY(), EMPTY_SPACE);
         } else if (currentCell == MINE_SHELL_COLLISION) {  // If it was a mine-shell collision, change back to mine
-            gameData.board[shell.getY()][shell.getX()] = MINE;
+            setCell(shell.getX(), shell.getY(), MINE);
         }
     }
     
@@ -335,7 +583,7 @@ void GameManager::moveShells() {
     auto collisionPositions = handleShellPositions(nextPositions);
 
     // Remove shells whose next position is in collisionPositions
-    std::set<std::pair<size_t, size_t>> collisionSet(collisionPositions.begin(), collisionPositions.end());
+    std::pmr::set<std::pair<size_t, size_t>> collisionSet(collisionPositions.begin(), collisionPositions.end(), arena.resource());
     for (int i = static_cast<int>(activeShells.size()) - 1; i >= 0; --i) {
         auto nextPos = activeShells[i].getPotentialMove();
         if (collisionSet.count(nextPos)) {
@@ -359,7 +607,56 @@ void GameManager::checkCollisions() {
     // 5. Tanks and other tanks
 }
 
+void GameManager::setupDecisionScheduler(const string& name1, const string& name2) {
+    decisionScheduler = nullptr;
+    decisionGroup.reset();
+    TaskScheduler* shared = sharedTaskScheduler ? sharedTaskScheduler() : nullptr;
+    if (options_.decisionThreads <= 1 && !shared) {
+        return;
+    }
+    // getAction() of different tanks may only run concurrently if both algorithms allow it
+    if (!options_.isThreadSafe(name1) || !options_.isThreadSafe(name2)) {
+        if (options_.decisionThreads > 1) {
+            std::cout << "Parallel decisions requested, but " << name1 << " and " << name2
+                      << " are not both declared thread-safe; deciding sequentially" << std::endl;
+        }
+        return;
+    }
+    // Prefer the simulator's pool, whose idle workers then help this game
+    if (shared) {
+        decisionScheduler = shared;
+    } else {
+        decisionGroup = make_unique<TaskGroup>(options_.decisionThreads - 1);
+        decisionScheduler = decisionGroup.get();
+    }
+}
+
+void GameManager::collectDecisions() {
+    // The tanks asked are the same ones updateTankVector() processes: a tank alive at this point
+    // either stays alive or is marked killed this round, so the set is known before any action runs
+    std::pmr::vector<TankInfo*> deciding(arena.resource());
+    for (auto* tanks : {&player1Tanks, &player2Tanks}) {
+        for (auto& tank : *tanks) {
+            if (tank.getIsAlive() || tank.getRoundWasKilled()) {
+                deciding.push_back(&tank);
+            }
+        }
+    }
+
+    decidedActions.resize(player1Tanks.size() + player2Tanks.size());
+    decisionScheduler->runAll(deciding.size(), [this, &deciding](size_t i) {
+        TankInfo& tank = *deciding[i];
+        decidedActions[static_cast<size_t>(tank.getCreationOrder())] = tank.getAlgorithm()->getAction();
+    });
+}
+
 void GameManager::updateTanks() {
+    // Parallel mode asks every tank first; the actions are still applied in the usual order below
+    if (decisionScheduler) {
+        std::cout << "\nCollecting tank decisions on " << decisionScheduler->concurrency() << " threads..." << std::endl;
+        collectDecisions();
+    }
+
     std::cout << "\nUpdating Player 1 tanks..." << std::endl;
     // Process player 1 tanks
     updateTankVector(player1Tanks);
@@ -373,7 +670,7 @@ void GameManager::updateTanks() {
     checkTankSwapping();
 }
 
-void GameManager::updateTankVector(vector<TankInfo>& tanks) {
+void GameManager::updateTankVector(std::pmr::vector<TankInfo>& tanks) {
     for (size_t i = 0; i < tanks.size(); i++) {
         auto& tank = tanks[i];
         
@@ -386,8 +683,12 @@ void GameManager::updateTankVector(vector<TankInfo>& tanks) {
                   << tank.getX() << "," << tank.getY() << ")" << std::endl;
         
         // Get action from tank's algorithm
-        auto action = tank.getAlgorithm()->getAction();
+        auto action = decisionScheduler ? decidedActions[static_cast<size_t>(tank.getCreationOrder())]
+                                    : tank.getAlgorithm()->getAction();
         std::cout << "Tank " << i << " chose action: " << static_cast<int>(action) << std::endl;
+        if (replayRecorder) {
+            replayRecorder->recordAction(tank.getCreationOrder(), action);
+        }
         
         // Store the action in tank's round info
         tank.setRoundAction(action);
@@ -405,8 +706,8 @@ void GameManager::updateTankVector(vector<TankInfo>& tanks) {
     }
 }
 
-map<pair<size_t, size_t>, TankInfo*> GameManager::createTankPositionMap() {
-    map<pair<size_t, size_t>, TankInfo*> currentPositions;
+std::pmr::map<pair<size_t, size_t>, TankInfo*> GameManager::createTankPositionMap() {
+    std::pmr::map<pair<size_t, size_t>, TankInfo*> currentPositions(arena.resource());
     
     // Add all alive tanks to the map
     for (auto& tank : player1Tanks) {
@@ -468,11 +769,11 @@ void GameManager::handleTankSwap(TankInfo* tank1, TankInfo* tank2) {
     // Kill both tanks
     tank1->killTank();
     tank1->setRoundWasKilled(true);
-    gameData.board[tank1->getY()][tank1->getX()] = EMPTY_SPACE;
+    setCell(tank1->getX(), tank1->getY(), EMPTY_SPACE);
     
     tank2->killTank();
     tank2->setRoundWasKilled(true);
-    gameData.board[tank2->getY()][tank2->getX()] = EMPTY_SPACE;
+    setCell(tank2->getX(), tank2->getY(), EMPTY_SPACE);
     
     // Update tank counts
     if (tank1->getPlayerId() == 1) {
@@ -550,8 +851,7 @@ bool GameManager::isValidTankAction(const TankInfo& tank, ActionRequest action)
             auto [nextX, nextY] = tank.getPotentialMove();
             
             // Check if the move is valid (not into a wall or damaged wall)
-            char nextCell = gameData.board[nextY][nextX];
-            return nextCell != WALL && nextCell != DAMAGED_WALL;
+            return !boardPlanes.test(BoardPlanes::BLOCKING, nextX, nextY);
         }
             
         case ActionRequest::Shoot:
@@ -570,8 +870,7 @@ bool GameManager::isValidTankAction(const TankInfo& tank, ActionRequest action)
             auto [nextX, nextY] = tank.getPotentialMoveBackwards();
             
             // Check if the move is valid (not into a wall or damaged wall)
-            char nextCell = gameData.board[nextY][nextX];
-            return nextCell != WALL && nextCell != DAMAGED_WALL;
+            return !boardPlanes.test(BoardPlanes::BLOCKING, nextX, nextY);
             }
             return true;
         }
@@ -619,7 +918,7 @@ void GameManager::processTankAction(TankInfo& tank, ActionRequest action) {
             std::cout << "Tank " << tank.getCreationOrder() << " (Player " << tank.getPlayerId() 
                       << ") attempting to move forward to (" << nextX << "," << nextY << ")" << std::endl;
             
-            if (nextCell == WALL || nextCell == DAMAGED_WALL) {
+            if (boardPlanes.test(BoardPlanes::BLOCKING, nextX, nextY)) {
                 // Move was invalid - mark as ignored
                 std::cout << "Tank " << tank.getCreationOrder() << " (Player " << tank.getPlayerId() 
                           << ") cannot move forward - blocked by " << nextCell << std::endl;
@@ -639,8 +938,8 @@ void GameManager::processTankAction(TankInfo& tank, ActionRequest action) {
                       << tank.getX() << "," << tank.getY() << ")" << std::endl;
             
             // Update both current and next positions
-            gameData.board[prevY][prevX] = getCurrentCellState(prevX, prevY);
-            gameData.board[tank.getY()][tank.getX()] = getNextCellState(nextCell, tank);
+            setCell(prevX, prevY, getCurrentCellState(prevX, prevY));
+            setCell(tank.getX(), tank.getY(), getNextCellState(nextCell, tank));
             break;
         }
             
@@ -663,7 +962,7 @@ void GameManager::processTankAction(TankInfo& tank, ActionRequest action) {
                 std::cout << "Tank " << tank.getCreationOrder() << " (Player " << tank.getPlayerId() 
                           << ") attempting to complete backward move to (" << nextX << "," << nextY << ")" << std::endl;
                 
-                if (nextCell == WALL || nextCell == DAMAGED_WALL) {
+                if (boardPlanes.test(BoardPlanes::BLOCKING, nextX, nextY)) {
                     // Move was invalid - mark as ignored
                     std::cout << "Tank " << tank.getCreationOrder() << " (Player " << tank.getPlayerId() 
                               << ") cannot complete backward move - blocked by " << nextCell << std::endl;
@@ -683,8 +982,8 @@ void GameManager::processTankAction(TankInfo& tank, ActionRequest action) {
                           << tank.getX() << "," << tank.getY() << ")" << std::endl;
                 
                 // Update both current and next positions
-                gameData.board[prevY][prevX] = getCurrentCellState(prevX, prevY);
-                gameData.board[tank.getY()][tank.getX()] = getNextCellState(nextCell, tank);
+                setCell(prevX, prevY, getCurrentCellState(prevX, prevY));
+                setCell(tank.getX(), tank.getY(), getNextCellState(nextCell, tank));
             }
             break;
         }
@@ -748,7 +1047,7 @@ void GameManager::processTankAction(TankInfo& tank, ActionRequest action) {
 
 void GameManager::addShell(const TankInfo& tank) {
     // Create a new shell at the tank's position with the tank's direction
-    Shell shell(tank.getX(), tank.getY(), tank.getDirection()[0], tank.getDirection()[1], gameData.columns, gameData.rows);
+    Shell shell(tank.getX(), tank.getY(), tank.getDirection().dx(), tank.getDirection().dy(), gameData.columns, gameData.rows);
     activeShells.push_back(shell);
 }
 
@@ -813,6 +1112,11 @@ char GameManager::getCurrentCellState(size_t x, size_t y) {
 }
 
 void GameManager::logRound() {
+    // Nothing to record in headless mode
+    if (!outputWriter) {
+        return;
+    }
+
     std::cout << "\nLogging round information..." << std::endl;
     
     // Get all tanks in a single vector using references
@@ -857,9 +1161,9 @@ void GameManager::printBoard() {
     std::cout << std::endl;
 }
 
-void GameManager::runGameLoop() {
+void GameManager::runGameLoop(size_t firstStep) {
     // Main game loop
-    for (size_t step = 0; step < gameData.maxStep; step++) {
+    for (size_t step = firstStep; step < gameData.maxStep; step++) {
         std::cout << "\n==================== Round " << step + 1 << " ====================" << std::endl;
         
         // Increment round counter in result
@@ -871,12 +1175,7 @@ void GameManager::runGameLoop() {
         
         // Begin new round for all tanks
         std::cout << "Starting new round for all tanks..." << std::endl;
-        for (auto& tank : player1Tanks) {
-            tank.beginRound();
-        }
-        for (auto& tank : player2Tanks) {
-            tank.beginRound();
-        }
+        tankTable.beginRound();
         
         // First shell movement
         std::cout << "First shell movement phase..." << std::endl;
@@ -889,18 +1188,25 @@ void GameManager::runGameLoop() {
         // Update tanks and check collisions
         std::cout << "Updating tanks and checking collisions..." << std::endl;
         updateTanks();
+        if (replayRecorder) {
+            replayRecorder->endRound();
+        }
         
-        // Log the round information
-        std::cout << "Logging round information..." << std::endl;
-        logRound();
-        outputWriter->writeCurrentRound();
+        // Log the round information (skipped entirely in headless mode)
+        if (outputWriter) {
+            std::cout << "Logging round information..." << std::endl;
+            logRound();
+            outputWriter->writeCurrentRound();
+        }
 
         // Round completed
         std::cout << "Round " << step + 1 << " completed" << std::endl;
 
         // Print current board state
-        std::cout << "Current board state after round " << step + 1 << ":" << std::endl;
-        printBoard();
+        if (verbose_) {
+            std::cout << "Current board state after round " << step + 1 << ":" << std::endl;
+            printBoard();
+        }
         
         // Print tank counts
         std::cout << "Player 1 tanks remaining: " << gameData.player1TankCount << std::endl;
@@ -913,6 +1219,16 @@ void GameManager::runGameLoop() {
             finalizeGameResult();
             return;  // Exit immediately after writing the game end message
         }
+
+        // Output files and replay streams must hold every round, so only headless games end early
+        if (options_.earlyTermination && !outputWriter && !replayRecorder && checkDecidedOutcome(step + 1)) {
+            finalizeGameResult();
+            return;
+        }
+
+        if (options_.snapshotInterval > 0 && (step + 1) % options_.snapshotInterval == 0) {
+            writeSnapshot(step + 1);
+        }
         
         std::cout << "Round " << step + 1 << " completed successfully" << std::endl;
     }
@@ -921,9 +1237,11 @@ void GameManager::runGameLoop() {
     std::cout << "Game reached maximum steps (" << gameData.maxStep << ")" << std::endl;
     updateGameResultReason(GameResult::MAX_STEPS);
     finalizeGameResult();
-    outputWriter->writeMaxStepsTie(gameData.maxStep, 
-        gameData.player1TankCount, 
-        gameData.player2TankCount);
+    if (outputWriter) {
+        outputWriter->writeMaxStepsTie(gameData.maxStep, 
+            gameData.player1TankCount, 
+            gameData.player2TankCount);
+    }
 }
 
 GameResult GameManager::run(size_t map_width, size_t map_height,
@@ -934,22 +1252,34 @@ GameResult GameManager::run(size_t map_width, size_t map_height,
     TankAlgorithmFactory player1_tank_algo_factory,
     TankAlgorithmFactory player2_tank_algo_factory) {
     
-    (void)name1; // Suppress unused parameter warning
-    (void)name2; // Suppress unused parameter warning
-    
     std::cout << "\nStarting game with new interface..." << std::endl;
+
+    // The simulator's sequential run of a game for its determinism check: decide one tank at a
+    // time, write no files, and play to the end like the checked game
+    if (isReferenceGame && isReferenceGame()) {
+        options_ = EngineOptions();
+        options_.earlyTermination = false;
+    }
     
     // Convert SatelliteView to internal board format
     convertSatelliteViewToBoard(map, map_width, map_height);
+    initialMapHash = EngineSnapshot::hashMap(gameData.board);
     
-    setOutputFile(map_name);
+    setupDecisionScheduler(name1, name2);
 
     // Set game parameters
     gameData.maxStep = max_steps;
     gameData.numShells = num_shells;
+
+    // The snapshot decides whether the output file is continued or started over
+    setSnapshotFile(map_name, name1, name2);
+    setOutputFile(map_name, pendingResume ? pendingResume->outputBytes : 0);
+    setReplayFile(map_name, name1, name2);
+    setEarlyEndFile(map_name, name1, name2);
     
     // Initialize game result
     initializeGameResult();
+    skippedRounds = 0;
     
     std::cout << "Initial board state:" << std::endl;
     printBoard();
@@ -957,19 +1287,45 @@ GameResult GameManager::run(size_t map_width, size_t map_height,
     std::cout << "Initializing players and tanks..." << std::endl;
     initializePlayersAndTanks(player1, player2, player1_tank_algo_factory, player2_tank_algo_factory);
 
-    if (checkImmediateGameEnd()) {
+    // Continue from a snapshot; the end-of-round checks already passed when it was taken
+    size_t firstStep = 0;
+    if (pendingResume) {
+        applySnapshot(*pendingResume);
+        firstStep = pendingResume->round;
+        gameResult.rounds = firstStep;
+        pendingResume.reset();
+        // A replay stream must start from the initial map
+        replayRecorder.reset();
+    }
+
+    if (replayRecorder) {
+        replayRecorder->begin(gameData.board, gameData.columns, gameData.rows, gameData.maxStep,
+                              gameData.numShells, player1Tanks.size() + player2Tanks.size());
+    }
+
+    if (firstStep == 0 && checkImmediateGameEnd()) {
         std::cout << "Game ended immediately due to initial conditions." << std::endl;
         finalizeGameResult();
+        if (replayRecorder) {
+            replayRecorder->finish(gameResult, gameData.columns, gameData.rows);
+        }
+        removeSnapshot();
         return std::move(gameResult);
     }
     
     std::cout << "Starting game loop..." << std::endl;
-    runGameLoop();
+    runGameLoop(firstStep);
     
     std::cout << "Game finished." << std::endl;
     
     // Finalize and return the result
     finalizeGameResult();
+    decisionScheduler = nullptr;
+    decisionGroup.reset();
+    if (replayRecorder) {
+        replayRecorder->finish(gameResult, gameData.columns, gameData.rows);
+    }
+    removeSnapshot();
     return std::move(gameResult);
 }
 
@@ -983,13 +1339,14 @@ void GameManager::convertSatelliteViewToBoard(const SatelliteView& map, size_t m
     gameData.player2TankCount = 0;
     
     // Initialize board with empty spaces
-    gameData.board.resize(map_height, vector<char>(map_width, EMPTY_SPACE));
+    gameData.board.resize(map_height, BoardRow(map_width, EMPTY_SPACE));
+    boardPlanes.reset(map_height, map_width);
     
     // Convert SatelliteView to internal board format
     for (size_t y = 0; y < map_height; y++) {
         for (size_t x = 0; x < map_width; x++) {
             char cell = map.getObjectAt(x, y);
-            gameData.board[y][x] = cell;
+            setCell(x, y, cell);
             
             // Count tanks for each player
             if (cell == PLAYER1_TANK) {
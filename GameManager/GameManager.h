@@ -6,6 +6,7 @@
 #include <map>
 #include <utility>
 #include <functional>
+#include <memory_resource>
 
 #include "../common/ActionRequest.h"
 #include "../common/BattleInfo.h"
@@ -17,9 +18,15 @@
 
 #include "../UserCommon/BoardConstants.h"
 #include "../UserCommon/BoardReader.h"
+#include "../UserCommon/BoardPlanes.h"
+#include "../UserCommon/GameArena.h"
 #include "TankInfo.h"
 #include "Shell.h"
 #include "OutputWriter.h"
+#include "ReplayLog.h"
+#include "EngineOptions.h"
+#include "EngineSnapshot.h"
+#include "TaskGroup.h"
 
 using namespace std;
 using namespace UserCommon_208000547_208000547;
@@ -41,21 +48,37 @@ struct TankRoundInfo {
 class GameManager final : public AbstractGameManager
 {
 private:
+    // Shells heading to each cell this round, keyed by position
+    using ShellTargets = std::pmr::map<pair<size_t, size_t>, std::pmr::vector<size_t>>;
+
+    // Backs every container below. Declared first so it outlives them; one GameManager plays one
+    // game in the simulator, so the game's memory is released in one go when it is destroyed.
+    GameArena arena;
     BoardData gameData;
+    BoardPlanes boardPlanes;  // Occupancy bit planes of gameData.board, kept in sync by setCell()
     Player* playerOne = nullptr;
     Player* playerTwo = nullptr;
-    int creationOrderCounter;  // Added to track tank creation order across both players
     bool verbose_;
-    unique_ptr<OutputWriter> outputWriter;
-    // Store tank information for each player
-    vector<TankInfo> player1Tanks;
-    vector<TankInfo> player2Tanks;
+    EngineOptions options_;
+    string snapshotFileName;  // Empty unless snapshots are written or resumed
+    uint64_t initialMapHash = 0;  // EngineSnapshot::hashMap() of the board run() started from
+    unique_ptr<EngineSnapshot> pendingResume;  // Applied by run() after the tanks are created
+    unique_ptr<OutputWriter> outputWriter;  // Null in headless (non-verbose) mode
+    unique_ptr<ReplayRecorder> replayRecorder;  // Null unless replay recording is enabled
+    TaskScheduler* decisionScheduler = nullptr;  // Null unless tank decisions are collected in parallel
+    unique_ptr<TaskGroup> decisionGroup;  // Own threads, used when the simulator shares no pool
+    std::pmr::vector<ActionRequest> decidedActions;  // Parallel getAction() results, indexed by creation order
+    // All tanks, in creation order
+    TankTable tankTable;
+    // Store tank information for each player (views of the table's rows)
+    std::pmr::vector<TankInfo> player1Tanks;
+    std::pmr::vector<TankInfo> player2Tanks;
     
     // Store active shells in the game
-    vector<Shell> activeShells;
+    std::pmr::vector<Shell> activeShells;
 
     // Store the board state at the start of each round
-    vector<vector<char>> roundStartBoard;
+    BoardGrid roundStartBoard;
     
     // Game result tracking
     GameResult gameResult;
@@ -65,13 +88,21 @@ private:
     void initializePlayersAndTanks(Player& player1, Player& player2, 
                                   TankAlgorithmFactory& player1_factory, 
                                   TankAlgorithmFactory& player2_factory);
-    void runGameLoop();
+    void runGameLoop(size_t firstStep);
     void logRound();  // Added to log round information for all tanks
-    void setOutputFile(string inputFileName);
+    // Creates the output writer (verbose only); a resumed game keeps the first resumeBytes bytes
+    // of its output file and appends to them
+    void setOutputFile(string inputFileName, uint64_t resumeBytes = 0);
+    void setReplayFile(const string& inputFileName, const string& name1, const string& name2);
+    void setEarlyEndFile(const string& inputFileName, const string& name1, const string& name2);
+    void setSnapshotFile(const string& inputFileName, const string& name1, const string& name2);
+    void writeSnapshot(size_t round);  // Write the current state to snapshotFileName
+    void removeSnapshot();  // Once the game is over and its result written, unless a replay is recorded
+    void applySnapshot(const EngineSnapshot& snapshot);  // Overwrite the engine state
     // Tank initialization helper functions
-    vector<TankPosition> collectTankPositions();
-    void sortTankPositions(vector<TankPosition>& positions);
-    void createTanksFromPositions(const vector<TankPosition>& positions, 
+    std::pmr::vector<TankPosition> collectTankPositions();
+    void sortTankPositions(std::pmr::vector<TankPosition>& positions);
+    void createTanksFromPositions(const std::pmr::vector<TankPosition>& positions, 
                                  TankAlgorithmFactory& player1_factory, 
                                  TankAlgorithmFactory& player2_factory);
 
@@ -79,11 +110,13 @@ private:
     void moveShells();  // Move all active shells once
     void checkCollisions();  // Check for collisions between all game objects
     void updateTanks();   // Get and process tank actions
-    void updateTankVector(vector<TankInfo>& tanks);  // Helper to update a vector of tanks
+    void updateTankVector(std::pmr::vector<TankInfo>& tanks);  // Helper to update a vector of tanks
+    void collectDecisions();  // Call getAction() for all tanks at once on the decision group
+    void setupDecisionScheduler(const string& name1, const string& name2);
     void checkTankSwapping();  // Check for tanks that swapped places
     
     // Tank swapping helper functions
-    map<pair<size_t, size_t>, TankInfo*> createTankPositionMap();  // Create map of current positions to tank pointers
+    std::pmr::map<pair<size_t, size_t>, TankInfo*> createTankPositionMap();  // Create map of current positions to tank pointers
     void handleTankSwap(TankInfo* tank1, TankInfo* tank2);  // Handle the case where two tanks swapped places
     bool tanksSwappedPlaces(TankInfo* tank1, TankInfo* tank2);  // Check if two tanks swapped places
     
@@ -92,11 +125,12 @@ private:
     void addShell(const TankInfo& tank);  // Create and add a new shell from a tank's position and direction
     char getNextCellState(char currentCell, const TankInfo& tank);  // Get the next cell state based on current cell and tank
     char getCurrentCellState(size_t x, size_t y);  // Get the current cell state after tank moves
+    void setCell(size_t x, size_t y, char cell);  // Write a board cell and its bit planes
 
     // Shell management
-    void detectShellCrossings(vector<bool>& shellsToRemove, map<pair<size_t, size_t>, vector<size_t>>& nextPositions);
-    void removeMarkedShells(const vector<bool>& shellsToRemove);
-    std::vector<std::pair<size_t, size_t>> handleShellPositions(const map<pair<size_t, size_t>, vector<size_t>>& nextPositions);
+    void detectShellCrossings(std::pmr::vector<bool>& shellsToRemove, ShellTargets& nextPositions);
+    void removeMarkedShells(const std::pmr::vector<bool>& shellsToRemove);
+    std::pmr::vector<std::pair<size_t, size_t>> handleShellPositions(const ShellTargets& nextPositions);
 
     // Collision handling helpers
     void handleTankCollision(const pair<size_t, size_t>& pos);
@@ -111,6 +145,9 @@ private:
     int roundsSinceNoShells;   // Count rounds since all tanks ran out of shells
 
     bool checkAllTanksOutOfShells();  // Helper function to check if all tanks are out of shells
+    bool checkDecidedOutcome(size_t completedRounds);  // End the game early if its outcome can no longer change
+    size_t skippedRounds;  // Rounds not played because the outcome was already decided
+    string earlyEndFileName;  // Where checkDecidedOutcome() logs a game it ends
 
     // Helper methods for the new interface
     void convertSatelliteViewToBoard(const SatelliteView& map, size_t map_width, size_t map_height);
@@ -121,6 +158,19 @@ private:
 public:
     explicit GameManager(bool verbose);
 
+    // Override the options read from the environment; call before run()
+    void setOptions(const EngineOptions& options) { options_ = options; }
+
+    // Make the next run() continue from a snapshot instead of round 0.
+    // run() must still be given the game's initial map so tanks are created in the same order.
+    void resumeFrom(const EngineSnapshot& snapshot) { pendingResume = make_unique<EngineSnapshot>(snapshot); }
+
+    // Rounds saved by ending the last game early (0 if it was played to the end)
+    size_t getSkippedRounds() const { return skippedRounds; }
+
+    // Engine state after `round` completed rounds
+    EngineSnapshot captureSnapshot(size_t round) const;
+
     GameResult run(size_t map_width, size_t map_height,
                 const SatelliteView& map,
                 std::string map_name,
@@ -1,14 +1,16 @@
 #include "MovableObject.h"
 #include <stdexcept>
-#include <vector>
+#include <string>
+
+using UserCommon_208000547_208000547::Direction;
 
 MovableObject::MovableObject(size_t x, size_t y, size_t width, size_t height)
-    : x(x), y(y), direction({-1, 0}), boardWidth(width), boardHeight(height) {}
+    : x(x), y(y), direction(Direction::Left), boardWidth(width), boardHeight(height) {}
 
 // Getters
 size_t MovableObject::getX() const { return x; }
 size_t MovableObject::getY() const { return y; }
-const std::array<int, 2>& MovableObject::getDirection() const { return direction; }
+Direction MovableObject::getDirection() const { return direction; }
 
 // Movement methods
 void MovableObject::move() {
@@ -31,15 +33,15 @@ void MovableObject::moveBackwards() {
 
 std::pair<size_t, size_t> MovableObject::getPotentialMove() const {
     // Calculate next position based on current direction
-    size_t nextX = (x + boardWidth + direction[0]) % boardWidth;
-    size_t nextY = (y + boardHeight + direction[1]) % boardHeight;
+    size_t nextX = (x + boardWidth + direction.dx()) % boardWidth;
+    size_t nextY = (y + boardHeight + direction.dy()) % boardHeight;
     return {nextX, nextY};
 }
 
 std::pair<size_t, size_t> MovableObject::getPotentialMoveBackwards() const {
     // Calculate next position based on opposite direction
-    size_t nextX = (x + boardWidth - direction[0]) % boardWidth;
-    size_t nextY = (y + boardHeight - direction[1]) % boardHeight;
+    size_t nextX = (x + boardWidth - direction.dx()) % boardWidth;
+    size_t nextY = (y + boardHeight - direction.dy()) % boardHeight;
     return {nextX, nextY};
 }
 
@@ -50,42 +52,15 @@ void MovableObject::setPosition(size_t newX, size_t newY) {
 
 // Direction methods
 void MovableObject::setDirection(int dx, int dy) {
-    direction = {dx, dy};
+    if (!Direction::fromDelta(dx, dy, direction)) {
+        throw std::runtime_error("Invalid direction (" + std::to_string(dx) + "," + std::to_string(dy) + ")");
+    }
 }
 
 void MovableObject::rotate90(bool clockwise) {
-    int x = direction[0];
-    int y = direction[1];
-    
-    if (clockwise) {
-        direction = {-y, x};
-    } else {
-        direction = {y, -x};
-    }
+    direction = direction.rotate90(clockwise);
 }
 
 void MovableObject::rotate45(bool clockwise) {
-    int x = direction[0];
-    int y = direction[1];
-    
-    static const std::vector<std::pair<int, int>> directions = {
-        {1, 0}, {1, 1}, {0, 1}, {-1, 1},
-        {-1, 0}, {-1, -1}, {0, -1}, {1, -1}
-    };
-
-    int currentIndex = -1;
-    for (int i = 0; i < 8; ++i) {
-        if (directions[i].first == x && directions[i].second == y) {
-            currentIndex = i;
-            break;
-        }
-    }
-
-    if (currentIndex == -1) {
-        throw std::runtime_error("Invalid direction");
-    }
-
-    int offset = clockwise ? 1 : -1;
-    int newIndex = (currentIndex + offset + 8) % 8;
-    direction = {directions[newIndex].first, directions[newIndex].second};
+    direction = direction.rotate45(clockwise);
 }
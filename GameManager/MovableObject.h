@@ -1,15 +1,15 @@
 #pragma once
-#include <array>
 #include <utility>
 #include <cstddef>  // for size_t
 #include <optional>
 #include <vector>
+#include "../UserCommon/Direction.h"
 
 class MovableObject {
 protected:
     size_t x;
     size_t y;
-    std::array<int, 2> direction;  // [x, y] direction vector
+    UserCommon_208000547_208000547::Direction direction;
     size_t boardWidth;
     size_t boardHeight;
     std::optional<std::pair<size_t, size_t>> previousPosition;  // Store previous position for swap detection
@@ -21,7 +21,7 @@ public:
     // Getters
     size_t getX() const;
     size_t getY() const;
-    const std::array<int, 2>& getDirection() const;
+    UserCommon_208000547_208000547::Direction getDirection() const;
     std::optional<std::pair<size_t, size_t>> getPreviousPosition() const { return previousPosition; }
     void clearPreviousPosition() { previousPosition = std::nullopt; }
 
@@ -33,7 +33,7 @@ public:
     virtual void setPosition(size_t newX, size_t newY);
 
     // Direction methods
-    virtual void setDirection(int dx, int dy);
+    virtual void setDirection(int dx, int dy);  // Throws if (dx, dy) is not one of the 8 directions
     virtual void rotate90(bool clockwise);
     virtual void rotate45(bool clockwise);
 }; 
\ No newline at end of file
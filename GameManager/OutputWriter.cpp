@@ -1,23 +1,79 @@
 #include "OutputWriter.h"
 #include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <filesystem>
 
-OutputWriter::OutputWriter(const std::string& fileName, bool verbose) : verbose(verbose) {
-    if (verbose) {
-        outputFile.open(fileName);
-        if (!outputFile.is_open()) {
-            throw std::runtime_error("Could not open output file: " + fileName);
+// Binary replay log layout (all integers little-endian):
+//   header:  "TGR1" followed by uint32 number of tanks
+//   round:   'R' followed by ceil(numTanks * 6 / 8) bytes of packed 6-bit tank codes
+//   end:     'E' followed by uint16 length and the game end line (without newline)
+// A tank code holds the action index in bits 0-3, "ignored" in bit 4 and "killed" in bit 5.
+// DEAD_TANK_CODE marks a tank that was killed in an earlier round.
+namespace {
+    const char BINARY_MAGIC[4] = {'T', 'G', 'R', '1'};
+    const char ROUND_TAG = 'R';
+    const char END_TAG = 'E';
+    const uint8_t DEAD_TANK_CODE = 0x3F;
+    const int BITS_PER_TANK = 6;
+
+    size_t packedRoundSize(size_t numTanks) {
+        return (numTanks * BITS_PER_TANK + 7) / 8;
+    }
+
+    void appendUint32(std::string& out, uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+        }
+    }
+
+    void appendUint16(std::string& out, uint16_t value) {
+        out.push_back(static_cast<char>(value & 0xFF));
+        out.push_back(static_cast<char>((value >> 8) & 0xFF));
+    }
+
+    bool readBytes(std::ifstream& in, char* dest, size_t count) {
+        return static_cast<bool>(in.read(dest, static_cast<std::streamsize>(count)));
+    }
+}
+
+OutputWriter::OutputWriter(const std::string& fileName, Format format, uint64_t keepBytes)
+    : format(format), binaryHeaderWritten(false), bytesOnDisk(0) {
+    std::ios::openmode mode = std::ios::out | std::ios::trunc;
+    if (keepBytes > 0) {
+        std::error_code error;
+        uintmax_t size = std::filesystem::file_size(fileName, error);
+        if (error || size < keepBytes) {
+            throw std::runtime_error("Output file is missing rounds to continue from: " + fileName);
         }
+        std::filesystem::resize_file(fileName, keepBytes);
+        mode = std::ios::out | std::ios::app;
+        // A non-empty binary log always starts with its header
+        binaryHeaderWritten = true;
+        bytesOnDisk = keepBytes;
+    }
+    if (format == Format::Binary) {
+        mode |= std::ios::binary;
     }
-    tankHistory = std::vector<std::vector<RoundInfo>>();
+    outputFile.open(fileName, mode);
+    if (!outputFile.is_open()) {
+        throw std::runtime_error("Could not open output file: " + fileName);
+    }
+    buffer.reserve(FLUSH_THRESHOLD + 4096);
 }
 
 OutputWriter::~OutputWriter() {
-    if (verbose && outputFile.is_open()) {
+    try {
+        flush();
+    } catch (...) {
+        // Never throw from a destructor
+    }
+    if (outputFile.is_open()) {
         outputFile.close();
     }
 }
 
-std::string OutputWriter::actionToString(ActionRequest action) const {
+const char* OutputWriter::actionToString(ActionRequest action) {
     switch (action) {
         case ActionRequest::MoveForward: return "MoveForward";
         case ActionRequest::MoveBackward: return "MoveBackward";
@@ -33,130 +89,203 @@ std::string OutputWriter::actionToString(ActionRequest action) const {
 }
 
 void OutputWriter::addRoundForTank(int tankId, const RoundInfo& info) {
-    std::cout << "Adding round for Tank " << tankId << std::endl;
-    // Ensure the tankHistory vector is large enough
-    if (static_cast<size_t>(tankId) >= tankHistory.size()) {
-        std::cout << "Tank " << tankId << " not found in history, creating new entry" << std::endl;
-        tankHistory.resize(static_cast<size_t>(tankId) + 1);
+    // Tanks are logged every round, so the vector only grows during the first round
+    if (static_cast<size_t>(tankId) >= currentRound.size()) {
+        currentRound.resize(static_cast<size_t>(tankId) + 1);
     }
-    
-    std::cout << "Tank " << tankId << " found in history, adding new round" << std::endl;
-    tankHistory[static_cast<size_t>(tankId)].push_back(info);
-    std::cout << "Added round for Tank " << tankId << ", history size: " << tankHistory[static_cast<size_t>(tankId)].size() << std::endl;
+    currentRound[static_cast<size_t>(tankId)] = info;
 }
 
-void OutputWriter::writeRoundToFile(const std::vector<RoundInfo>& currentRound) {
-    if (!verbose) {
-        return;
-    }
-    
-    bool firstAction = true;
-    
+void OutputWriter::appendRoundText(std::string& out, const std::vector<RoundInfo>& round) {
     // Write actions in order of tank IDs
-    for (size_t tankId = 0; tankId < currentRound.size(); ++tankId) {
-        if (!firstAction) {
-            outputFile << ", ";
+    for (size_t tankId = 0; tankId < round.size(); ++tankId) {
+        if (tankId > 0) {
+            out.append(", ");
         }
-        firstAction = false;
 
-        const auto& info = currentRound[tankId];
+        const auto& info = round[tankId];
         if (!info.isAlive && !info.wasKilled) {
             // Tank was already dead in previous rounds
-            outputFile << "killed";
+            out.append("killed");
         } else {
             // Tank is either alive or was just killed this round
-            outputFile << actionToString(info.action);
-            
+            out.append(actionToString(info.action));
+
             if (info.wasActionIgnored) {
-                outputFile << " (ignored)";
+                out.append(" (ignored)");
             }
-            
+
             if (info.wasKilled) {
-                outputFile << " (killed)";
+                out.append(" (killed)");
             }
         }
     }
-    outputFile << std::endl;
+    out.push_back('\n');
+}
+
+uint8_t OutputWriter::encodeTankRound(const RoundInfo& info) {
+    if (!info.isAlive && !info.wasKilled) {
+        return DEAD_TANK_CODE;
+    }
+    uint8_t code = static_cast<uint8_t>(info.action) & 0x0F;
+    if (info.wasActionIgnored) code |= 0x10;
+    if (info.wasKilled) code |= 0x20;
+    return code;
+}
+
+RoundInfo OutputWriter::decodeTankRound(uint8_t code) {
+    RoundInfo info;
+    if (code == DEAD_TANK_CODE) {
+        info.isAlive = false;
+        info.action = ActionRequest::DoNothing;
+        info.wasActionIgnored = false;
+        info.wasKilled = false;
+        return info;
+    }
+    info.action = static_cast<ActionRequest>(code & 0x0F);
+    info.wasActionIgnored = (code & 0x10) != 0;
+    info.wasKilled = (code & 0x20) != 0;
+    info.isAlive = !info.wasKilled;
+    return info;
 }
 
-void OutputWriter::writeOutputFile() {
-    if (!verbose) {
+void OutputWriter::writeBinaryHeader() {
+    if (binaryHeaderWritten) {
         return;
     }
-    
-    // Get the number of rounds from any tank's history
-    if (tankHistory.empty()) {
+    buffer.append(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    appendUint32(buffer, static_cast<uint32_t>(currentRound.size()));
+    binaryHeaderWritten = true;
+}
+
+void OutputWriter::writeRoundToBuffer() {
+    if (format == Format::Text) {
+        appendRoundText(buffer, currentRound);
         return;
     }
-    
-    size_t numRounds = tankHistory[0].size();
-    
-    // For each round, collect the info for all tanks
-    for (size_t round = 0; round < numRounds; ++round) {
-        std::vector<RoundInfo> currentRound;
-        currentRound.reserve(tankHistory.size());
-        
-        // Collect info for all tanks in this round
-        for (size_t tankId = 0; tankId < tankHistory.size(); ++tankId) {
-            if (round < tankHistory[tankId].size()) {
-                currentRound.push_back(tankHistory[tankId][round]);
-            }
+
+    writeBinaryHeader();
+    buffer.push_back(ROUND_TAG);
+    size_t start = buffer.size();
+    buffer.append(packedRoundSize(currentRound.size()), '\0');
+    for (size_t tankId = 0; tankId < currentRound.size(); ++tankId) {
+        uint32_t code = encodeTankRound(currentRound[tankId]);
+        size_t bit = tankId * BITS_PER_TANK;
+        size_t byte = start + bit / 8;
+        uint32_t shifted = code << (bit % 8);
+        buffer[byte] = static_cast<char>(static_cast<uint8_t>(buffer[byte]) | (shifted & 0xFF));
+        if (shifted > 0xFF) {
+            buffer[byte + 1] = static_cast<char>(static_cast<uint8_t>(buffer[byte + 1]) | (shifted >> 8));
         }
-        
-        writeRoundToFile(currentRound);
     }
 }
 
-void OutputWriter::writeGameEnd(int winner, int remainingTanks) {
-    if (!verbose) {
-        return;
-    }
-    
-    if (winner == 0) {
-        outputFile << "Tie, both players have zero tanks" << std::endl;
+void OutputWriter::writeEndLine(const std::string& line) {
+    if (format == Format::Text) {
+        buffer.append(line);
+        buffer.push_back('\n');
     } else {
-        outputFile << "Player " << winner << " won with " << remainingTanks << " tanks still alive" << std::endl;
+        writeBinaryHeader();
+        buffer.push_back(END_TAG);
+        appendUint16(buffer, static_cast<uint16_t>(line.size()));
+        buffer.append(line);
     }
+    // The end line is the last thing written for a game
+    flush();
 }
 
-void OutputWriter::writeMaxStepsTie(int maxSteps, int player1Tanks, int player2Tanks) {
-    if (!verbose) {
-        return;
+void OutputWriter::flushIfNeeded() {
+    if (buffer.size() >= FLUSH_THRESHOLD) {
+        flush();
     }
-    
-    outputFile << "Tie, reached max steps = " << maxSteps 
-               << ", player 1 has " << player1Tanks 
-               << " tanks, player 2 has " << player2Tanks << " tanks" << std::endl;
 }
 
-void OutputWriter::writeZeroShellsTie() {
-    if (!verbose) {
+void OutputWriter::flush() {
+    if (buffer.empty() || !outputFile.is_open()) {
         return;
     }
-    
-    outputFile << "Tie, both players have zero shells for <" << ZERO_SHELLS_STEPS << "> steps" << std::endl;
+    outputFile.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    outputFile.flush();
+    bytesOnDisk += buffer.size();
+    buffer.clear();
 }
 
 void OutputWriter::writeCurrentRound() {
-    if (!verbose) {
+    if (currentRound.empty()) {
         return;
     }
-    
-    if (tankHistory.empty()) {
-        return;
+    writeRoundToBuffer();
+    flushIfNeeded();
+}
+
+void OutputWriter::writeGameEnd(int winner, int remainingTanks) {
+    if (winner == 0) {
+        writeEndLine("Tie, both players have zero tanks");
+    } else {
+        writeEndLine("Player " + std::to_string(winner) + " won with " + std::to_string(remainingTanks) + " tanks still alive");
     }
-    
-    size_t currentRoundNum = tankHistory[0].size() - 1;
-    
-    // Collect info for all tanks in this round
-    std::vector<RoundInfo> currentRound;
-    currentRound.reserve(tankHistory.size());
-    
-    for (size_t tankId = 0; tankId < tankHistory.size(); ++tankId) {
-        if (currentRoundNum < tankHistory[tankId].size()) {
-            currentRound.push_back(tankHistory[tankId][currentRoundNum]);
+}
+
+void OutputWriter::writeMaxStepsTie(int maxSteps, int player1Tanks, int player2Tanks) {
+    writeEndLine("Tie, reached max steps = " + std::to_string(maxSteps)
+                 + ", player 1 has " + std::to_string(player1Tanks)
+                 + " tanks, player 2 has " + std::to_string(player2Tanks) + " tanks");
+}
+
+void OutputWriter::writeZeroShellsTie() {
+    writeEndLine("Tie, both players have zero shells for <" + std::to_string(ZERO_SHELLS_STEPS) + "> steps");
+}
+
+void OutputWriter::convertBinaryToText(const std::string& binaryFileName, const std::string& textFileName) {
+    std::ifstream in(binaryFileName, std::ios::binary);
+    if (!in.is_open()) {
+        throw std::runtime_error("Could not open binary replay log: " + binaryFileName);
+    }
+
+    char magic[4];
+    if (!readBytes(in, magic, sizeof(magic)) || !std::equal(magic, magic + 4, BINARY_MAGIC)) {
+        throw std::runtime_error("Not a binary replay log: " + binaryFileName);
+    }
+    unsigned char countBytes[4];
+    if (!readBytes(in, reinterpret_cast<char*>(countBytes), sizeof(countBytes))) {
+        throw std::runtime_error("Truncated replay log header: " + binaryFileName);
+    }
+    size_t numTanks = static_cast<size_t>(countBytes[0]) | (static_cast<size_t>(countBytes[1]) << 8)
+                    | (static_cast<size_t>(countBytes[2]) << 16) | (static_cast<size_t>(countBytes[3]) << 24);
+
+    OutputWriter writer(textFileName, Format::Text);
+    std::vector<unsigned char> packed(packedRoundSize(numTanks));
+    writer.currentRound.resize(numTanks);
+
+    char tag;
+    while (in.get(tag)) {
+        if (tag == ROUND_TAG) {
+            if (!readBytes(in, reinterpret_cast<char*>(packed.data()), packed.size())) {
+                throw std::runtime_error("Truncated round record in " + binaryFileName);
+            }
+            for (size_t tankId = 0; tankId < numTanks; ++tankId) {
+                size_t bit = tankId * BITS_PER_TANK;
+                size_t byte = bit / 8;
+                uint32_t word = packed[byte];
+                if (byte + 1 < packed.size()) {
+                    word |= static_cast<uint32_t>(packed[byte + 1]) << 8;
+                }
+                uint8_t code = static_cast<uint8_t>((word >> (bit % 8)) & DEAD_TANK_CODE);
+                writer.currentRound[tankId] = decodeTankRound(code);
+            }
+            writer.writeCurrentRound();
+        } else if (tag == END_TAG) {
+            unsigned char lengthBytes[2];
+            if (!readBytes(in, reinterpret_cast<char*>(lengthBytes), sizeof(lengthBytes))) {
+                throw std::runtime_error("Truncated end record in " + binaryFileName);
+            }
+            std::string line(static_cast<size_t>(lengthBytes[0]) | (static_cast<size_t>(lengthBytes[1]) << 8), '\0');
+            if (!line.empty() && !readBytes(in, &line[0], line.size())) {
+                throw std::runtime_error("Truncated end record in " + binaryFileName);
+            }
+            writer.writeEndLine(line);
+        } else {
+            throw std::runtime_error("Unknown record tag in " + binaryFileName);
         }
     }
-    
-    writeRoundToFile(currentRound);
-} 
\ No newline at end of file
+}
@@ -2,35 +2,66 @@
 #include <string>
 #include <fstream>
 #include <vector>
-#include <map>
+#include <cstdint>
 #include "../common/ActionRequest.h"
 #include "RoundInfo.h"
 
+// Append-only writer for the per-game output file.
+// Rounds are formatted into a reusable buffer which is flushed to disk in large blocks.
+// Only the current round is kept in memory, so memory use does not depend on game length.
 class OutputWriter {
+public:
+    enum class Format {
+        Text,    // The assignment's human readable format
+        Binary   // Compact replay log: 6 bits per tank per round (see convertBinaryToText)
+    };
+
 private:
     std::ofstream outputFile;
-    bool verbose;
-    
-    // 2D vector matrix to store tank history
-    // First dimension: tank ID
-    // Second dimension: round number
-    std::vector<std::vector<RoundInfo>> tankHistory;
+    Format format;
+
+    // Info for every tank in the round currently being logged, indexed by tank ID
+    std::vector<RoundInfo> currentRound;
+
+    // Pending bytes not yet written to the file
+    std::string buffer;
+    bool binaryHeaderWritten;
+    uint64_t bytesOnDisk;  // File length after the last flush
+
+    static constexpr size_t FLUSH_THRESHOLD = 64 * 1024;
 
-    void writeRoundToFile(const std::vector<RoundInfo>& currentRound);
-    std::string actionToString(ActionRequest action) const;
+    void writeRoundToBuffer();
+    void writeEndLine(const std::string& line);
+    void writeBinaryHeader();
+    void flushIfNeeded();
+
+    static const char* actionToString(ActionRequest action);
+    static void appendRoundText(std::string& out, const std::vector<RoundInfo>& round);
+    static uint8_t encodeTankRound(const RoundInfo& info);
+    static RoundInfo decodeTankRound(uint8_t code);
 
 public:
-    OutputWriter(const std::string& fileName, bool verbose = true);
+    // With keepBytes > 0, continues a file this writer wrote before (see EngineSnapshot::outputBytes):
+    // the file is cut back to its first keepBytes bytes and appended to.
+    // Throws std::runtime_error if the file cannot be opened or is shorter than that.
+    OutputWriter(const std::string& fileName, Format format = Format::Text, uint64_t keepBytes = 0);
     ~OutputWriter();
 
+    // Write everything buffered so far to the file
+    void flush();
+    uint64_t getBytesOnDisk() const { return bytesOnDisk; }
+
     static constexpr int ZERO_SHELLS_STEPS = 40;
 
     void addRoundForTank(int tankId, const RoundInfo& info);
-    void writeOutputFile();
     void writeCurrentRound();
-    
+
     // Game end conditions
     void writeGameEnd(int winner, int remainingTanks);
     void writeMaxStepsTie(int maxSteps, int player1Tanks, int player2Tanks);
     void writeZeroShellsTie();
-}; 
\ No newline at end of file
+
+    // Convert a binary replay log into the text output format.
+    // Throws std::runtime_error if the input cannot be read or is malformed.
+    static void convertBinaryToText(const std::string& binaryFileName, const std::string& textFileName);
+};
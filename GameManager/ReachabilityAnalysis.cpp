@@ -0,0 +1,74 @@
+#include "ReachabilityAnalysis.h"
+#include <deque>
+#include "../UserCommon/BoardConstants.h"
+#include "../UserCommon/Direction.h"
+
+using namespace UserCommon_208000547_208000547;
+
+namespace GameManager_208000547_208000547 {
+
+namespace {
+    const int NO_OWNER = -1;
+
+    bool isHazard(char cell) {
+        // Tanks move over empty cells and other tanks' start cells; anything else kills them
+        return cell != EMPTY_SPACE && cell != PLAYER1_TANK && cell != PLAYER2_TANK
+            && cell != WALL && cell != DAMAGED_WALL;
+    }
+}
+
+bool canAnyTankBeDestroyed(const BoardGrid& board,
+                           const std::vector<std::pair<size_t, size_t>>& tankPositions,
+                           size_t horizon) {
+    size_t rows = board.size();
+    size_t columns = rows == 0 ? 0 : board[0].size();
+    if (rows == 0 || columns == 0) {
+        return false;
+    }
+
+    // Cells reachable by a tank are claimed by it; reaching a claimed cell means two tanks can meet
+    std::vector<int> owner(rows * columns, NO_OWNER);
+    std::vector<size_t> depth(rows * columns, 0);
+    std::deque<size_t> frontier;
+
+    for (size_t tank = 0; tank < tankPositions.size(); ++tank) {
+        int tankId = static_cast<int>(tank);
+        size_t start = tankPositions[tank].second * columns + tankPositions[tank].first;
+        if (owner[start] != NO_OWNER) {
+            return true;  // Two tanks on the same cell
+        }
+        owner[start] = tankId;
+        depth[start] = 0;
+        frontier.clear();
+        frontier.push_back(start);
+
+        while (!frontier.empty()) {
+            size_t cell = frontier.front();
+            frontier.pop_front();
+            if (depth[cell] == horizon) {
+                continue;
+            }
+            size_t x = cell % columns;
+            size_t y = cell / columns;
+            for (int d = 0; d < 8; ++d) {
+                Direction dir = Direction::fromIndex(d);
+                size_t nx = (x + columns + dir.dx()) % columns;
+                size_t ny = (y + rows + dir.dy()) % rows;
+                size_t next = ny * columns + nx;
+                char nextCell = board[ny][nx];
+                if (nextCell == WALL || nextCell == DAMAGED_WALL || owner[next] == tankId) {
+                    continue;
+                }
+                if (owner[next] != NO_OWNER || isHazard(nextCell)) {
+                    return true;
+                }
+                owner[next] = tankId;
+                depth[next] = depth[cell] + 1;
+                frontier.push_back(next);
+            }
+        }
+    }
+    return false;
+}
+
+} // namespace GameManager_208000547_208000547
@@ -0,0 +1,19 @@
+#pragma once
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "../UserCommon/GameArena.h"
+
+namespace GameManager_208000547_208000547 {
+
+// Whether any tank could be destroyed within `horizon` rounds, assuming no shells are in
+// flight and no tank has shells left. Without shells the walls are permanent, so a tank can
+// only die by driving onto a mine (or any unresolved collision cell) or by meeting another tank.
+// Each tank moves at most one cell per round in any of the 8 directions and the board wraps
+// around, so a depth-limited BFS from every tank bounds where it can be when the game ends.
+bool canAnyTankBeDestroyed(const UserCommon_208000547_208000547::BoardGrid& board,
+                           const std::vector<std::pair<size_t, size_t>>& tankPositions,
+                           size_t horizon);
+
+} // namespace GameManager_208000547_208000547
@@ -0,0 +1,110 @@
+#include "ReplayEngine.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace GameManager_208000547_208000547 {
+
+namespace {
+    // Satellite view returning the recorded board cells unchanged
+    class ReplayMapView : public SatelliteView {
+    private:
+        const BoardGrid& board;
+    public:
+        explicit ReplayMapView(const BoardGrid& board) : board(board) {}
+        char getObjectAt(size_t x, size_t y) const override {
+            if (y >= board.size() || x >= board[y].size()) {
+                return INVALID_LOCATION;
+            }
+            return board[y][x];
+        }
+    };
+
+    // Players are only consulted for battle info, which recorded tanks don't need
+    class ReplayPlayer : public Player {
+    public:
+        void updateTankWithBattleInfo(TankAlgorithm&, SatelliteView&) override {}
+    };
+
+    // Plays back the actions recorded for one tank
+    class ReplayTankAlgorithm : public TankAlgorithm {
+    private:
+        const ReplayLog& log;
+        size_t tankId;
+        size_t nextRound;
+    public:
+        ReplayTankAlgorithm(const ReplayLog& log, size_t tankId, size_t firstRound)
+            : log(log), tankId(tankId), nextRound(firstRound) {}
+
+        ActionRequest getAction() override {
+            // A tank is asked every round until it dies, so its actions form a prefix of the rounds
+            while (nextRound < log.getRecordedRounds()) {
+                uint8_t code = log.actionAt(nextRound++, tankId);
+                if (code != ReplayLog::NO_ACTION) {
+                    return static_cast<ActionRequest>(code);
+                }
+            }
+            return ActionRequest::DoNothing;
+        }
+
+        void updateBattleInfo(BattleInfo&) override {}
+    };
+}
+
+ReplayEngine::ReplayEngine(const ReplayLog& log) : log(log), nextTankId(0) {}
+
+GameResult ReplayEngine::simulate(size_t roundLimit) {
+    return run(nullptr, roundLimit);
+}
+
+GameResult ReplayEngine::simulateFrom(const EngineSnapshot& snapshot, size_t roundLimit) {
+    if (snapshot.columns != log.getColumns() || snapshot.rows != log.getRows() ||
+        snapshot.tanks.size() != log.getNumTanks() || snapshot.maxSteps != log.getMaxSteps()) {
+        throw std::runtime_error("Snapshot does not belong to this replay stream");
+    }
+    return run(&snapshot, roundLimit);
+}
+
+GameResult ReplayEngine::run(const EngineSnapshot* snapshot, size_t roundLimit) {
+    // Tanks are created in creation order, so the n-th factory call is tank n
+    size_t firstRound = snapshot ? snapshot->round : 0;
+    nextTankId = 0;
+    TankAlgorithmFactory factory = [this, firstRound](int, int) -> unique_ptr<TankAlgorithm> {
+        return make_unique<ReplayTankAlgorithm>(log, static_cast<size_t>(nextTankId++), firstRound);
+    };
+
+    ReplayMapView map(log.getInitialBoard());
+    ReplayPlayer player1;
+    ReplayPlayer player2;
+    gameManager = make_unique<GameManager>(false);
+    // Replays must not write replay streams or snapshots of their own, and the recorded
+    // game was played to the end because it was recording
+    EngineOptions options;
+    options.earlyTermination = false;
+    gameManager->setOptions(options);
+    if (snapshot) {
+        gameManager->resumeFrom(*snapshot);
+    }
+    return gameManager->run(log.getColumns(), log.getRows(), map, "replay",
+                            std::min(log.getMaxSteps(), roundLimit), log.getNumShells(),
+                            player1, "replay", player2, "replay", factory, factory);
+}
+
+bool ReplayEngine::verify(uint64_t* replayedHash) {
+    GameResult result = simulate();
+    uint64_t hash = hashGameResult(result, log.getColumns(), log.getRows());
+    if (replayedHash) {
+        *replayedHash = hash;
+    }
+    return log.isFinished() && hash == log.getFinalHash();
+}
+
+bool ReplayEngine::verifyFrom(const EngineSnapshot& snapshot, uint64_t* replayedHash) {
+    GameResult result = simulateFrom(snapshot);
+    uint64_t hash = hashGameResult(result, log.getColumns(), log.getRows());
+    if (replayedHash) {
+        *replayedHash = hash;
+    }
+    return log.isFinished() && hash == log.getFinalHash();
+}
+
+} // namespace GameManager_208000547_208000547
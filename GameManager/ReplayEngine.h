@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+#include "GameManager.h"
+#include "ReplayLog.h"
+#include "EngineSnapshot.h"
+
+namespace GameManager_208000547_208000547 {
+
+// Re-simulates a recorded game from its replay stream.
+// Every tank's algorithm is replaced by one that plays back the recorded actions,
+// so no algorithm .so is loaded and no decision logic runs.
+class ReplayEngine {
+private:
+    const ReplayLog& log;
+    unique_ptr<GameManager> gameManager;  // Kept alive so the returned game state stays valid
+    int nextTankId;
+
+public:
+    explicit ReplayEngine(const ReplayLog& log);
+
+    // Re-simulate the game, stopping after roundLimit rounds if the game lasts that long.
+    // The returned gameState is valid until the next call to simulate().
+    GameResult simulate(size_t roundLimit = std::numeric_limits<size_t>::max());
+
+    // Same as simulate(), but starts from a snapshot taken while the recorded game ran
+    GameResult simulateFrom(const EngineSnapshot& snapshot, size_t roundLimit = std::numeric_limits<size_t>::max());
+
+    // Re-simulate the whole game and compare its final state hash with the recorded one
+    bool verify(uint64_t* replayedHash = nullptr);
+    bool verifyFrom(const EngineSnapshot& snapshot, uint64_t* replayedHash = nullptr);
+
+private:
+    GameResult run(const EngineSnapshot* snapshot, size_t roundLimit);
+};
+
+} // namespace GameManager_208000547_208000547
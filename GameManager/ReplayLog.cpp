@@ -0,0 +1,180 @@
+#include "ReplayLog.h"
+#include <stdexcept>
+#include <algorithm>
+
+namespace GameManager_208000547_208000547 {
+
+namespace {
+    const char REPLAY_MAGIC[4] = {'T', 'G', 'P', '1'};
+    const char ROUND_TAG = 'R';
+    const char END_TAG = 'E';
+    const size_t FLUSH_THRESHOLD = 64 * 1024;
+
+    size_t packedRoundSize(size_t numTanks) {
+        return (numTanks + 1) / 2;
+    }
+
+    void appendUint(std::string& out, uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+        }
+    }
+
+    uint64_t readUint(std::ifstream& in, int bytes, const std::string& fileName) {
+        unsigned char data[8];
+        if (!in.read(reinterpret_cast<char*>(data), bytes)) {
+            throw std::runtime_error("Truncated replay stream: " + fileName);
+        }
+        uint64_t value = 0;
+        for (int i = 0; i < bytes; ++i) {
+            value |= static_cast<uint64_t>(data[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    // 64-bit FNV-1a
+    const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+    const uint64_t FNV_PRIME = 1099511628211ULL;
+
+    void hashValue(uint64_t& hash, uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            hash ^= (value >> (8 * i)) & 0xFF;
+            hash *= FNV_PRIME;
+        }
+    }
+}
+
+uint64_t hashGameResult(const GameResult& result, size_t width, size_t height) {
+    uint64_t hash = FNV_OFFSET;
+    hashValue(hash, width);
+    hashValue(hash, height);
+    if (result.gameState) {
+        for (size_t y = 0; y < height; ++y) {
+            for (size_t x = 0; x < width; ++x) {
+                hash ^= static_cast<unsigned char>(result.gameState->getObjectAt(x, y));
+                hash *= FNV_PRIME;
+            }
+        }
+    }
+    hashValue(hash, static_cast<uint64_t>(result.winner));
+    hashValue(hash, static_cast<uint64_t>(result.reason));
+    hashValue(hash, result.rounds);
+    for (size_t tanks : result.remaining_tanks) {
+        hashValue(hash, tanks);
+    }
+    return hash;
+}
+
+ReplayRecorder::ReplayRecorder(const std::string& fileName) {
+    file.open(fileName, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open replay file: " + fileName);
+    }
+    buffer.reserve(FLUSH_THRESHOLD + 4096);
+}
+
+ReplayRecorder::~ReplayRecorder() {
+    try {
+        flush();
+    } catch (...) {
+        // Never throw from a destructor
+    }
+}
+
+void ReplayRecorder::flush() {
+    if (buffer.empty() || !file.is_open()) {
+        return;
+    }
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    file.flush();
+    buffer.clear();
+}
+
+void ReplayRecorder::begin(const UserCommon_208000547_208000547::BoardGrid& board, size_t columns, size_t rows,
+                           size_t maxSteps, size_t numShells, size_t numTanks) {
+    buffer.append(REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+    appendUint(buffer, columns, 4);
+    appendUint(buffer, rows, 4);
+    appendUint(buffer, maxSteps, 4);
+    appendUint(buffer, numShells, 4);
+    appendUint(buffer, numTanks, 4);
+    for (size_t y = 0; y < rows; ++y) {
+        buffer.append(board[y].data(), columns);
+    }
+    currentRound.assign(numTanks, ReplayLog::NO_ACTION);
+}
+
+void ReplayRecorder::recordAction(int tankId, ActionRequest action) {
+    currentRound[static_cast<size_t>(tankId)] = static_cast<uint8_t>(action);
+}
+
+void ReplayRecorder::endRound() {
+    buffer.push_back(ROUND_TAG);
+    for (size_t i = 0; i < currentRound.size(); i += 2) {
+        uint8_t low = currentRound[i];
+        uint8_t high = (i + 1 < currentRound.size()) ? currentRound[i + 1] : ReplayLog::NO_ACTION;
+        buffer.push_back(static_cast<char>(low | (high << 4)));
+    }
+    std::fill(currentRound.begin(), currentRound.end(), ReplayLog::NO_ACTION);
+    if (buffer.size() >= FLUSH_THRESHOLD) {
+        flush();
+    }
+}
+
+void ReplayRecorder::finish(const GameResult& result, size_t width, size_t height) {
+    buffer.push_back(END_TAG);
+    appendUint(buffer, result.rounds, 4);
+    appendUint(buffer, static_cast<uint64_t>(result.winner), 1);
+    appendUint(buffer, static_cast<uint64_t>(result.reason), 1);
+    appendUint(buffer, hashGameResult(result, width, height), 8);
+    flush();
+}
+
+ReplayLog::ReplayLog(const std::string& fileName)
+    : finished(false), finalRounds(0), finalWinner(0), finalReason(GameResult::MAX_STEPS), finalHash(0) {
+    std::ifstream in(fileName, std::ios::binary);
+    if (!in.is_open()) {
+        throw std::runtime_error("Could not open replay file: " + fileName);
+    }
+
+    char magic[4];
+    if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + 4, REPLAY_MAGIC)) {
+        throw std::runtime_error("Not a replay stream: " + fileName);
+    }
+    columns = readUint(in, 4, fileName);
+    rows = readUint(in, 4, fileName);
+    maxSteps = readUint(in, 4, fileName);
+    numShells = readUint(in, 4, fileName);
+    numTanks = readUint(in, 4, fileName);
+
+    board.assign(rows, UserCommon_208000547_208000547::BoardRow(columns));
+    for (size_t y = 0; y < rows; ++y) {
+        if (!in.read(board[y].data(), static_cast<std::streamsize>(columns))) {
+            throw std::runtime_error("Truncated replay board: " + fileName);
+        }
+    }
+
+    std::vector<unsigned char> packed(packedRoundSize(numTanks));
+    char tag;
+    while (in.get(tag)) {
+        if (tag == ROUND_TAG) {
+            if (!in.read(reinterpret_cast<char*>(packed.data()), static_cast<std::streamsize>(packed.size()))) {
+                throw std::runtime_error("Truncated replay round: " + fileName);
+            }
+            for (size_t tankId = 0; tankId < numTanks; ++tankId) {
+                unsigned char byte = packed[tankId / 2];
+                actions.push_back((tankId % 2 == 0) ? (byte & 0x0F) : (byte >> 4));
+            }
+        } else if (tag == END_TAG) {
+            finalRounds = readUint(in, 4, fileName);
+            finalWinner = static_cast<int>(readUint(in, 1, fileName));
+            finalReason = static_cast<GameResult::Reason>(readUint(in, 1, fileName));
+            finalHash = readUint(in, 8, fileName);
+            finished = true;
+        } else {
+            throw std::runtime_error("Unknown record tag in replay stream: " + fileName);
+        }
+    }
+}
+
+} // namespace GameManager_208000547_208000547
@@ -0,0 +1,87 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../common/ActionRequest.h"
+#include "../common/SatelliteView.h"
+#include "../common/GameResult.h"
+#include "../UserCommon/GameArena.h"
+
+namespace GameManager_208000547_208000547 {
+
+// Replay stream layout (all integers little-endian):
+//   header:  "TGP1", uint32 columns, rows, max_steps, num_shells, number of tanks,
+//            followed by rows * columns bytes of the initial board
+//   round:   'R' followed by ceil(numTanks / 2) bytes, one nibble per tank in creation order
+//            holding the ActionRequest returned by getAction(), or NO_ACTION if it was not asked
+//   end:     'E' followed by uint32 rounds, uint8 winner, uint8 reason and uint64 final state hash
+// The stream holds everything needed to re-simulate a game without loading any algorithm.
+
+// Hash of a finished game: final board, winner, reason, rounds and remaining tanks
+uint64_t hashGameResult(const GameResult& result, size_t width, size_t height);
+
+class ReplayRecorder {
+private:
+    std::ofstream file;
+    std::string buffer;
+    std::vector<uint8_t> currentRound;  // One action code per tank, reset every round
+
+    void flush();
+
+public:
+    explicit ReplayRecorder(const std::string& fileName);
+    ~ReplayRecorder();
+
+    void begin(const UserCommon_208000547_208000547::BoardGrid& board, size_t columns, size_t rows,
+               size_t maxSteps, size_t numShells, size_t numTanks);
+    void recordAction(int tankId, ActionRequest action);
+    void endRound();
+    void finish(const GameResult& result, size_t width, size_t height);
+};
+
+class ReplayLog {
+public:
+    static constexpr uint8_t NO_ACTION = 0x0F;
+
+private:
+    size_t columns;
+    size_t rows;
+    size_t maxSteps;
+    size_t numShells;
+    size_t numTanks;
+    UserCommon_208000547_208000547::BoardGrid board;
+    std::vector<uint8_t> actions;  // rounds * numTanks action codes
+    bool finished;
+    size_t finalRounds;
+    int finalWinner;
+    GameResult::Reason finalReason;
+    uint64_t finalHash;
+
+public:
+    // Throws std::runtime_error if the file cannot be read or is malformed
+    explicit ReplayLog(const std::string& fileName);
+
+    size_t getColumns() const { return columns; }
+    size_t getRows() const { return rows; }
+    size_t getMaxSteps() const { return maxSteps; }
+    size_t getNumShells() const { return numShells; }
+    size_t getNumTanks() const { return numTanks; }
+    size_t getRecordedRounds() const { return numTanks == 0 ? 0 : actions.size() / numTanks; }
+    const UserCommon_208000547_208000547::BoardGrid& getInitialBoard() const { return board; }
+
+    // Action code for a tank in a round (0-based), NO_ACTION if the tank was not asked
+    uint8_t actionAt(size_t round, size_t tankId) const { return actions[round * numTanks + tankId]; }
+
+    // Recorded outcome, only valid when isFinished()
+    bool isFinished() const { return finished; }
+    size_t getFinalRounds() const { return finalRounds; }
+    int getFinalWinner() const { return finalWinner; }
+    GameResult::Reason getFinalReason() const { return finalReason; }
+    uint64_t getFinalHash() const { return finalHash; }
+};
+
+} // namespace GameManager_208000547_208000547
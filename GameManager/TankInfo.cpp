@@ -1,5 +1,9 @@
 #include "TankInfo.h"
 #include <iostream>
+#include <stdexcept>
+#include <string>
+
+using UserCommon_208000547_208000547::Direction;
 
 // All possible directions in the game:
 // Cardinal directions (90 degrees):
@@ -31,44 +35,72 @@
 // - RotateRight90 -> [0,-1] (Up)
 // - RotateRight90 -> [1,0] (Right) - back to start
 
-TankInfo::TankInfo(size_t x, size_t y, int dx, int dy, std::unique_ptr<TankAlgorithm> algo, size_t width, size_t height, int playerId, int creationOrder, int numShells)
-    : MovableObject(x, y, width, height), isAlive(true), shootCooldown(0),
-      algorithm(std::move(algo)), playerId(playerId), creationOrder(creationOrder),
-      backwardMoveCounter(0), isMovingBackward(false), numShells(numShells) {
-    clearRoundInfo();
-    roundInfo.isAlive = true;
-    // Set the initial direction
-    setDirection(dx, dy);
-    std::cout << "Tank " << creationOrder << " has " << numShells << " shells" << std::endl;
+// Movement (the board wraps around)
+std::pair<size_t, size_t> TankInfo::getPotentialMove() const {
+    Direction dir = table->direction[index];
+    size_t nextX = (getX() + table->width + dir.dx()) % table->width;
+    size_t nextY = (getY() + table->height + dir.dy()) % table->height;
+    return {nextX, nextY};
+}
+
+std::pair<size_t, size_t> TankInfo::getPotentialMoveBackwards() const {
+    Direction dir = table->direction[index];
+    size_t nextX = (getX() + table->width - dir.dx()) % table->width;
+    size_t nextY = (getY() + table->height - dir.dy()) % table->height;
+    return {nextX, nextY};
+}
+
+void TankInfo::rememberPosition() {
+    table->prevX[index] = table->x[index];
+    table->prevY[index] = table->y[index];
+    setFlag(TankTable::HasPrevious, true);
+}
+
+void TankInfo::move() {
+    auto [newX, newY] = getPotentialMove();
+    rememberPosition();
+    setPosition(newX, newY);
 }
 
-// Tank-specific getters
-bool TankInfo::getIsAlive() const { return isAlive; }
-int TankInfo::getShootCooldown() const { return shootCooldown; }
-TankAlgorithm* TankInfo::getAlgorithm() { return algorithm.get(); }
+void TankInfo::moveBackwards() {
+    auto [newX, newY] = getPotentialMoveBackwards();
+    rememberPosition();
+    setPosition(newX, newY);
+}
+
+void TankInfo::setDirection(int dx, int dy) {
+    if (!Direction::fromDelta(dx, dy, table->direction[index])) {
+        throw std::runtime_error("Invalid direction (" + std::to_string(dx) + "," + std::to_string(dy) + ")");
+    }
+}
+
+void TankInfo::setPosition(size_t newX, size_t newY) {
+    table->x[index] = static_cast<uint16_t>(newX);
+    table->y[index] = static_cast<uint16_t>(newY);
+}
 
 // Tank-specific actions
 void TankInfo::killTank() { 
-    isAlive = false; 
-    roundInfo.isAlive = false;
-    roundInfo.wasKilled = true;
+    setFlag(TankTable::Alive, false);
+    setFlag(TankTable::RoundAlive, false);
+    setFlag(TankTable::RoundKilled, true);
 }
-void TankInfo::startShootCooldown() { shootCooldown = 4; }  // Assuming 2 turns cooldown
-void TankInfo::updateShootCooldown() { if (shootCooldown > 0) shootCooldown--; }
+void TankInfo::startShootCooldown() { table->cooldown[index] = 4; }  // Assuming 2 turns cooldown
 
 void TankInfo::rotate(ActionRequest action) {
+    Direction& dir = table->direction[index];
     switch (action) {
         case ActionRequest::RotateLeft90:
-            rotate90(false);
+            dir = dir.rotate90(false);
             break;
         case ActionRequest::RotateRight90:
-            rotate90(true);
+            dir = dir.rotate90(true);
             break;
         case ActionRequest::RotateLeft45:
-            rotate45(false);
+            dir = dir.rotate45(false);
             break;
         case ActionRequest::RotateRight45:
-            rotate45(true);
+            dir = dir.rotate45(true);
             break;
         default:
             break;
@@ -76,20 +108,26 @@ void TankInfo::rotate(ActionRequest action) {
 }
 
 void TankInfo::startBackwardMove() {
-    if (!isMovingBackward) {
-        isMovingBackward = true;
-        backwardMoveCounter = 0;
+    if (!getIsMovingBackward()) {
+        setFlag(TankTable::MovingBackward, true);
+        table->backwardCounter[index] = 0;
     }
 }
 
 void TankInfo::cancelBackwardMove() {
-    isMovingBackward = false;
-    backwardMoveCounter = 0;
+    setFlag(TankTable::MovingBackward, false);
+    table->backwardCounter[index] = 0;
 }
 
-void TankInfo::updateBackwardMove() {
-    if (isMovingBackward) {
-        backwardMoveCounter++;
-    }
+void TankInfo::restoreState(bool alive, int cooldown, bool movingBackward, int backwardCounter, int shells) {
+    setFlag(TankTable::Alive, alive);
+    table->cooldown[index] = static_cast<uint8_t>(cooldown);
+    setFlag(TankTable::MovingBackward, movingBackward);
+    table->backwardCounter[index] = static_cast<uint16_t>(backwardCounter);
+    table->shells[index] = shells;
+    table->roundAction[index] = ActionRequest::DoNothing;
+    setFlag(TankTable::RoundActionIgnored, false);
+    setFlag(TankTable::RoundKilled, false);
+    setFlag(TankTable::RoundAlive, alive);
+    setFlag(TankTable::HasPrevious, false);
 }
-
@@ -1,72 +1,82 @@
 #pragma once
-#include <memory>
-#include "MovableObject.h"
+#include <cstddef>
+#include <cstdint>
 #include <functional>
-#include "../common/BattleInfo.h"
+#include <memory>
+#include <utility>
+#include <optional>
+#include <iostream>
 #include "../common/ActionRequest.h"
+#include "../common/BattleInfo.h"
 #include "../common/TankAlgorithm.h"
 #include "RoundInfo.h"
-#include <optional>
-#include <iostream>
+#include "TankTable.h"
 
-class TankInfo : public MovableObject {
+// A tank of the game, as a view of its row in the GameManager's TankTable.
+// Cheap to copy; stays valid for as long as the table keeps its tanks.
+class TankInfo {
 private:
-    bool isAlive;
-    int shootCooldown;  // Count of turns until next shoot is available
-    std::unique_ptr<TankAlgorithm> algorithm;
-    RoundInfo roundInfo;  // Added to store round information
-    int playerId;  // Added to track which player owns this tank
-    int creationOrder;  // Added to track the order of creation in the board
-    int backwardMoveCounter;  // Counter for backward movement steps
-    bool isMovingBackward;  // Flag to track if tank is in backward movement sequence
-    int numShells;  // Number of shells the tank has
+    TankTable* table;
+    size_t index;  // Row in the table, which is also the tank's creation order
+
+    bool hasFlag(uint8_t flag) const { return (table->flags[index] & flag) != 0; }
+    void setFlag(uint8_t flag, bool value) {
+        if (value) {
+            table->flags[index] |= flag;
+        } else {
+            table->flags[index] &= static_cast<uint8_t>(~flag);
+        }
+    }
+    void rememberPosition();  // Store the current position as the previous one before moving
 
 public:
-    TankInfo(size_t x, size_t y, int dx, int dy, std::unique_ptr<TankAlgorithm> algo, size_t width, size_t height, int playerId, int creationOrder, int numShells);
+    TankInfo(TankTable& table, size_t index) : table(&table), index(index) {}
+
+    // Position and movement
+    size_t getX() const { return table->x[index]; }
+    size_t getY() const { return table->y[index]; }
+    UserCommon_208000547_208000547::Direction getDirection() const { return table->direction[index]; }
+    std::optional<std::pair<size_t, size_t>> getPreviousPosition() const {
+        if (!hasFlag(TankTable::HasPrevious)) {
+            return std::nullopt;
+        }
+        return std::pair<size_t, size_t>(table->prevX[index], table->prevY[index]);
+    }
+    std::pair<size_t, size_t> getPotentialMove() const;
+    std::pair<size_t, size_t> getPotentialMoveBackwards() const;
+    void move();
+    void moveBackwards();
+    void setPosition(size_t newX, size_t newY);
+    void setDirection(int dx, int dy);  // Throws if (dx, dy) is not one of the 8 directions
 
     // Tank-specific getters
-    bool getIsAlive() const;
-    int getShootCooldown() const;
-    TankAlgorithm* getAlgorithm();
-    int getPlayerId() const { return playerId; }
-    int getCreationOrder() const { return creationOrder; }
-    bool getIsMovingBackward() const { return isMovingBackward; }
-    int getBackwardMoveCounter() const { return backwardMoveCounter; }
-    int getNumShells() const { return numShells; }
-    void setNumShells(int shells) { numShells = shells; std::cout << "Tank " << creationOrder << " has " << numShells << " shells" << std::endl; }
+    bool getIsAlive() const { return hasFlag(TankTable::Alive); }
+    int getShootCooldown() const { return table->cooldown[index]; }
+    TankAlgorithm* getAlgorithm() { return table->algorithms[index].get(); }
+    int getPlayerId() const { return table->playerId[index]; }
+    int getCreationOrder() const { return static_cast<int>(index); }
+    bool getIsMovingBackward() const { return hasFlag(TankTable::MovingBackward); }
+    int getBackwardMoveCounter() const { return table->backwardCounter[index]; }
+    int getNumShells() const { return table->shells[index]; }
+    void setNumShells(int shells) { table->shells[index] = shells; std::cout << "Tank " << index << " has " << shells << " shells" << std::endl; }
 
     // RoundInfo getters and setters
-    bool getRoundIsAlive() const { return roundInfo.isAlive; }
-    ActionRequest getRoundAction() const { return roundInfo.action; }
-    bool getRoundWasActionIgnored() const { return roundInfo.wasActionIgnored; }
-    bool getRoundWasKilled() const { return roundInfo.wasKilled; }
+    bool getRoundIsAlive() const { return hasFlag(TankTable::RoundAlive); }
+    ActionRequest getRoundAction() const { return table->roundAction[index]; }
+    bool getRoundWasActionIgnored() const { return hasFlag(TankTable::RoundActionIgnored); }
+    bool getRoundWasKilled() const { return hasFlag(TankTable::RoundKilled); }
     
-    void setRoundIsAlive(bool value) { roundInfo.isAlive = value; }
-    void setRoundAction(ActionRequest action) { roundInfo.action = action; }
-    void setRoundWasActionIgnored(bool value) { roundInfo.wasActionIgnored = value; }
-    void setRoundWasKilled(bool value) { roundInfo.wasKilled = value; }
-    
-    void clearRoundInfo() {
-        roundInfo.action = ActionRequest::DoNothing;
-        roundInfo.wasActionIgnored = false;
-        roundInfo.wasKilled = false;
-    }
+    void setRoundIsAlive(bool value) { setFlag(TankTable::RoundAlive, value); }
+    void setRoundAction(ActionRequest action) { table->roundAction[index] = action; }
+    void setRoundWasActionIgnored(bool value) { setFlag(TankTable::RoundActionIgnored, value); }
+    void setRoundWasKilled(bool value) { setFlag(TankTable::RoundKilled, value); }
 
     // Tank-specific actions
     void killTank();
     void rotate(ActionRequest action);
     void startShootCooldown();
-    void updateShootCooldown();
     void startBackwardMove();
     void cancelBackwardMove();
-    void updateBackwardMove();
-    void resetRoundFlags() { 
-        updateShootCooldown();       // Update cooldown
-    }
-    void beginRound() {
-        clearRoundInfo();           // Clear round info
-        updateShootCooldown();      // Update cooldown
-        updateBackwardMove();       // Update backward movement state
-        clearPreviousPosition();    // Clear previous position
-    }
+    // Overwrite the mutable tank state, used when resuming from an engine snapshot
+    void restoreState(bool alive, int cooldown, bool movingBackward, int backwardCounter, int shells);
 }; 
\ No newline at end of file
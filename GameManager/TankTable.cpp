@@ -0,0 +1,59 @@
+#include "TankTable.h"
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+TankTable::TankTable(std::pmr::memory_resource* resource)
+    : x(resource), y(resource), prevX(resource), prevY(resource), direction(resource), flags(resource),
+      cooldown(resource), backwardCounter(resource), shells(resource), playerId(resource),
+      roundAction(resource), algorithms(resource) {}
+
+void TankTable::reset(size_t boardWidth, size_t boardHeight, size_t capacity) {
+    const size_t limit = std::numeric_limits<uint16_t>::max();
+    if (boardWidth > limit || boardHeight > limit) {
+        throw std::runtime_error("Board of " + std::to_string(boardWidth) + "x" + std::to_string(boardHeight) +
+                                 " exceeds the tank table's 16-bit coordinates");
+    }
+    width = static_cast<uint16_t>(boardWidth);
+    height = static_cast<uint16_t>(boardHeight);
+
+    x.clear(); y.clear(); prevX.clear(); prevY.clear();
+    direction.clear(); flags.clear(); cooldown.clear(); backwardCounter.clear();
+    shells.clear(); playerId.clear(); roundAction.clear(); algorithms.clear();
+
+    x.reserve(capacity); y.reserve(capacity); prevX.reserve(capacity); prevY.reserve(capacity);
+    direction.reserve(capacity); flags.reserve(capacity); cooldown.reserve(capacity);
+    backwardCounter.reserve(capacity); shells.reserve(capacity); playerId.reserve(capacity);
+    roundAction.reserve(capacity); algorithms.reserve(capacity);
+}
+
+size_t TankTable::add(size_t tankX, size_t tankY, UserCommon_208000547_208000547::Direction dir, int player, int numShells,
+                      std::unique_ptr<TankAlgorithm> algorithm) {
+    x.push_back(static_cast<uint16_t>(tankX));
+    y.push_back(static_cast<uint16_t>(tankY));
+    prevX.push_back(0);
+    prevY.push_back(0);
+    direction.push_back(dir);
+    flags.push_back(Alive | RoundAlive);
+    cooldown.push_back(0);
+    backwardCounter.push_back(0);
+    shells.push_back(numShells);
+    playerId.push_back(static_cast<uint8_t>(player));
+    roundAction.push_back(ActionRequest::DoNothing);
+    algorithms.push_back(std::move(algorithm));
+    return x.size() - 1;
+}
+
+void TankTable::beginRound() {
+    const uint8_t roundInfo = RoundKilled | RoundActionIgnored;
+    for (size_t i = 0; i < size(); ++i) {
+        roundAction[i] = ActionRequest::DoNothing;
+        if (cooldown[i] > 0) {
+            cooldown[i]--;
+        }
+        if ((flags[i] & MovingBackward) && backwardCounter[i] < std::numeric_limits<uint16_t>::max()) {
+            backwardCounter[i]++;
+        }
+        flags[i] &= static_cast<uint8_t>(~(roundInfo | HasPrevious));
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+#include "../common/ActionRequest.h"
+#include "../common/BattleInfo.h"
+#include "../common/TankAlgorithm.h"
+#include "../UserCommon/Direction.h"
+
+// All tanks of one game, stored column by column and indexed by creation order.
+// The per-round state every phase walks over (position, direction, flags, cooldown, shells) is
+// packed into small parallel arrays, so a pass over all tanks reads a few cache lines; the
+// algorithms, only touched when a tank is asked for its action, are kept in a separate array.
+// Coordinates are 16-bit, so boards are limited to 65535 columns and rows.
+struct TankTable {
+    // Bits of `flags`
+    enum Flag : uint8_t {
+        Alive = 1 << 0,
+        MovingBackward = 1 << 1,
+        HasPrevious = 1 << 2,         // prevX/prevY hold the position before this round's move
+        RoundAlive = 1 << 3,          // Round info reported to the output writer
+        RoundKilled = 1 << 4,
+        RoundActionIgnored = 1 << 5,
+    };
+
+    uint16_t width = 0;
+    uint16_t height = 0;
+
+    // Hot columns
+    std::pmr::vector<uint16_t> x, y;
+    std::pmr::vector<uint16_t> prevX, prevY;
+    std::pmr::vector<UserCommon_208000547_208000547::Direction> direction;
+    std::pmr::vector<uint8_t> flags;
+    std::pmr::vector<uint8_t> cooldown;
+    std::pmr::vector<uint16_t> backwardCounter;  // Saturates instead of wrapping around
+    std::pmr::vector<int32_t> shells;
+    std::pmr::vector<uint8_t> playerId;
+    std::pmr::vector<ActionRequest> roundAction;
+
+    // Cold column
+    std::pmr::vector<std::unique_ptr<TankAlgorithm>> algorithms;
+
+    explicit TankTable(std::pmr::memory_resource* resource);
+
+    // Drop all tanks and prepare for `capacity` tanks on a width x height board
+    void reset(size_t boardWidth, size_t boardHeight, size_t capacity);
+
+    // Append a tank; returns its index (= creation order)
+    size_t add(size_t tankX, size_t tankY, UserCommon_208000547_208000547::Direction dir, int player, int numShells, std::unique_ptr<TankAlgorithm> algorithm);
+
+    size_t size() const { return x.size(); }
+
+    // Start-of-round update of every tank: clear the round info, tick the cooldown and the
+    // backward move, forget the previous position
+    void beginRound();
+};
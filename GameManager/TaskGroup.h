@@ -0,0 +1,98 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../UserCommon/TaskScheduler.h"
+
+// Fixed set of helper threads that run one batch of indexed tasks at a time.
+// The calling thread works on the batch too, so a group with N helpers uses N + 1 threads.
+// Used by a single game, which hands it one batch per round, when the simulator offers no shared pool.
+class TaskGroup : public UserCommon_208000547_208000547::TaskScheduler {
+public:
+    explicit TaskGroup(std::size_t helpers)
+        : stop_(false), generation_(0), count_(0), next_(0), remaining_(0), task_(nullptr) {
+        for (std::size_t i = 0; i < helpers; ++i) {
+            threads_.emplace_back([this] {
+                std::size_t seen = 0;
+                for (;;) {
+                    {
+                        std::unique_lock<std::mutex> lk(m_);
+                        cv_work_.wait(lk, [&] { return stop_ || generation_ != seen; });
+                        if (stop_) return;
+                        seen = generation_;
+                    }
+                    work(seen);
+                }
+            });
+        }
+    }
+
+    ~TaskGroup() override {
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            stop_ = true;
+        }
+        cv_work_.notify_all();
+        for (auto& t : threads_) if (t.joinable()) t.join();
+    }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    std::size_t concurrency() const override { return threads_.size() + 1; }
+
+    void runAll(std::size_t count, const std::function<void(std::size_t)>& task) override {
+        if (count == 0) return;
+        std::size_t generation;
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            task_ = &task;
+            count_ = count;
+            next_ = 0;
+            remaining_ = count;
+            error_ = nullptr;
+            generation = ++generation_;
+        }
+        cv_work_.notify_all();
+        work(generation);
+
+        std::unique_lock<std::mutex> lk(m_);
+        cv_done_.wait(lk, [this] { return remaining_ == 0; });
+        task_ = nullptr;
+        if (error_) std::rethrow_exception(error_);
+    }
+
+private:
+    // Claims are made under the lock, so a helper waking up late never runs a task of a newer batch
+    // with a stale index. Tasks are whole getAction() calls, which dwarf the locking cost.
+    void work(std::size_t generation) {
+        std::unique_lock<std::mutex> lk(m_);
+        while (generation_ == generation && next_ < count_) {
+            std::size_t i = next_++;
+            const std::function<void(std::size_t)>* task = task_;
+            lk.unlock();
+            std::exception_ptr error;
+            try { (*task)(i); }
+            catch (...) { error = std::current_exception(); }
+            lk.lock();
+            if (error && !error_) error_ = error;
+            if (--remaining_ == 0) cv_done_.notify_all();
+        }
+    }
+
+    std::vector<std::thread> threads_;
+    std::mutex m_;
+    std::condition_variable cv_work_;
+    std::condition_variable cv_done_;
+    bool stop_;
+    std::size_t generation_;
+    std::size_t count_;
+    std::size_t next_;
+    std::size_t remaining_;
+    const std::function<void(std::size_t)>* task_;
+    std::exception_ptr error_;
+};
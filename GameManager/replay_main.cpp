@@ -0,0 +1,148 @@
+// Command line tool for working with GameManager replay logs.
+// Usage:
+//   replay_208000547_208000547 to-text <binary_log> <text_output>
+//   replay_208000547_208000547 verify <replay_stream> [snapshot] [-verbose]
+//   replay_208000547_208000547 seek <replay_stream> <round> [snapshot] [-verbose]
+// With a snapshot, re-simulation starts from the snapshot's round instead of round 0.
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <chrono>
+#include <stdexcept>
+#include "OutputWriter.h"
+#include "ReplayLog.h"
+#include "ReplayEngine.h"
+#include "EngineSnapshot.h"
+#include "../common/GameManagerRegistration.h"
+
+using namespace GameManager_208000547_208000547;
+
+// The tool links the engine directly, so the registration hook has nothing to register with
+GameManagerRegistration::GameManagerRegistration(GameManagerFactory) {}
+
+namespace {
+    void printUsage(const std::string& programName) {
+        std::cout << "Usage:" << std::endl;
+        std::cout << "  " << programName << " to-text <binary_log> <text_output>" << std::endl;
+        std::cout << "  " << programName << " verify <replay_stream> [snapshot] [-verbose]" << std::endl;
+        std::cout << "  " << programName << " seek <replay_stream> <round> [snapshot] [-verbose]" << std::endl;
+    }
+
+    const char* reasonToString(GameResult::Reason reason) {
+        switch (reason) {
+            case GameResult::ALL_TANKS_DEAD: return "ALL_TANKS_DEAD";
+            case GameResult::MAX_STEPS: return "MAX_STEPS";
+            case GameResult::ZERO_SHELLS: return "ZERO_SHELLS";
+            default: return "UNKNOWN";
+        }
+    }
+
+    // Discards everything written to it
+    class NullBuffer : public std::streambuf {
+    protected:
+        int overflow(int c) override { return traits_type::not_eof(c); }
+    };
+
+    // Silences the engine's console logging while re-simulating
+    class QuietScope {
+    private:
+        NullBuffer sink;
+        std::streambuf* previous;
+    public:
+        explicit QuietScope(bool quiet) : previous(nullptr) {
+            if (quiet) previous = std::cout.rdbuf(&sink);
+        }
+        ~QuietScope() {
+            if (previous) std::cout.rdbuf(previous);
+        }
+    };
+
+    int runVerify(const std::string& fileName, const std::string& snapshotFile, bool verbose) {
+        ReplayLog log(fileName);
+        ReplayEngine engine(log);
+        uint64_t hash = 0;
+        bool ok;
+        auto start = std::chrono::high_resolution_clock::now();
+        if (snapshotFile.empty()) {
+            QuietScope quiet(!verbose);
+            ok = engine.verify(&hash);
+        } else {
+            EngineSnapshot snapshot = EngineSnapshot::readFromFile(snapshotFile);
+            std::cout << "Starting from snapshot at round " << snapshot.round << std::endl;
+            QuietScope quiet(!verbose);
+            ok = engine.verifyFrom(snapshot, &hash);
+        }
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::high_resolution_clock::now() - start);
+
+        if (!log.isFinished()) {
+            std::cout << "Replay stream has no recorded outcome (the game did not finish); replayed "
+                      << log.getRecordedRounds() << " rounds, hash " << std::hex << hash << std::dec << std::endl;
+            return 2;
+        }
+        std::cout << "Recorded: " << log.getFinalRounds() << " rounds, winner " << log.getFinalWinner()
+                  << " (" << reasonToString(log.getFinalReason()) << "), hash " << std::hex << log.getFinalHash() << std::dec << std::endl;
+        std::cout << "Replayed hash " << std::hex << hash << std::dec << " in " << duration.count() << "ms" << std::endl;
+        std::cout << (ok ? "Replay matches the recorded game" : "Replay DIVERGES from the recorded game") << std::endl;
+        return ok ? 0 : 2;
+    }
+
+    int runSeek(const std::string& fileName, size_t round, const std::string& snapshotFile, bool verbose) {
+        ReplayLog log(fileName);
+        ReplayEngine engine(log);
+        GameResult result;
+        if (snapshotFile.empty()) {
+            QuietScope quiet(!verbose);
+            result = engine.simulate(round);
+        } else {
+            EngineSnapshot snapshot = EngineSnapshot::readFromFile(snapshotFile);
+            if (snapshot.round > round) {
+                throw std::runtime_error("Snapshot is past round " + std::to_string(round));
+            }
+            QuietScope quiet(!verbose);
+            result = engine.simulateFrom(snapshot, round);
+        }
+
+        std::cout << "State after round " << result.rounds << ":" << std::endl;
+        for (size_t y = 0; y < log.getRows(); ++y) {
+            for (size_t x = 0; x < log.getColumns(); ++x) {
+                std::cout << (result.gameState ? result.gameState->getObjectAt(x, y) : ' ');
+            }
+            std::cout << std::endl;
+        }
+        std::cout << "Tanks remaining - Player 1: " << result.remaining_tanks[0]
+                  << ", Player 2: " << result.remaining_tanks[1] << std::endl;
+        std::cout << "State hash: " << std::hex << hashGameResult(result, log.getColumns(), log.getRows()) << std::dec << std::endl;
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::string command = argv[1];
+    bool verbose = std::string(argv[argc - 1]) == "-verbose";
+    int positional = verbose ? argc - 1 : argc;
+    try {
+        if (command == "to-text" && positional == 4) {
+            OutputWriter::convertBinaryToText(argv[2], argv[3]);
+            std::cout << "Converted " << argv[2] << " to " << argv[3] << std::endl;
+            return 0;
+        }
+        if (command == "verify" && (positional == 3 || positional == 4)) {
+            return runVerify(argv[2], positional == 4 ? argv[3] : "", verbose);
+        }
+        if (command == "seek" && (positional == 4 || positional == 5)) {
+            return runSeek(argv[2], static_cast<size_t>(std::stoul(argv[3])), positional == 5 ? argv[4] : "", verbose);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    printUsage(argv[0]);
+    return 1;
+}
@@ -15,6 +15,7 @@ struct CommandLineArgs {
     std::string algorithm1;
     std::string algorithm2;
     int numThreads = 1;
+    std::string affinity = "none";
     
     std::vector<std::string> unsupportedArgs;
     std::vector<std::string> missingArgs;
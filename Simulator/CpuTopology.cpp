@@ -0,0 +1,145 @@
+#include "CpuTopology.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <pthread.h>
+#include <sched.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+    // Parses the kernel's cpulist format ("0-3,8,10-11")
+    bool parseCpuList(const std::string& text, std::vector<int>& cpus) {
+        cpus.clear();
+        std::stringstream ss(text);
+        std::string range;
+        while (std::getline(ss, range, ',')) {
+            range.erase(std::remove_if(range.begin(), range.end(), ::isspace), range.end());
+            if (range.empty()) {
+                continue;
+            }
+            try {
+                size_t dash = range.find('-');
+                int first = std::stoi(range.substr(0, dash));
+                int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+                if (first < 0 || last < first) {
+                    return false;
+                }
+                for (int cpu = first; cpu <= last; ++cpu) {
+                    cpus.push_back(cpu);
+                }
+            } catch (const std::exception&) {
+                return false;
+            }
+        }
+        return !cpus.empty();
+    }
+}
+
+bool AffinitySpec::parse(const std::string& value, AffinitySpec& spec) {
+    spec = AffinitySpec{};
+    if (value == "none") {
+        spec.policy = Policy::None;
+    } else if (value == "compact") {
+        spec.policy = Policy::Compact;
+    } else if (value == "scatter") {
+        spec.policy = Policy::Scatter;
+    } else if (parseCpuList(value, spec.cpus)) {
+        spec.policy = Policy::List;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+CpuTopology CpuTopology::detect() {
+    CpuTopology topology;
+    std::vector<std::pair<int, std::vector<int>>> found;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator("/sys/devices/system/node", ec)) {
+        std::string name = entry.path().filename().string();
+        if (name.rfind("node", 0) != 0 || name.size() == 4 || !std::isdigit(static_cast<unsigned char>(name[4]))) {
+            continue;
+        }
+        std::ifstream in(entry.path() / "cpulist");
+        std::string text;
+        std::vector<int> cpus;
+        if (std::getline(in, text) && parseCpuList(text, cpus)) {
+            found.emplace_back(std::stoi(name.substr(4)), cpus);
+        }
+    }
+    std::sort(found.begin(), found.end());
+    for (auto& node : found) {
+        topology.nodes.push_back(std::move(node.second));
+    }
+
+    if (topology.nodes.empty()) {
+        unsigned int count = std::max(1u, std::thread::hardware_concurrency());
+        topology.nodes.emplace_back();
+        for (unsigned int cpu = 0; cpu < count; ++cpu) {
+            topology.nodes[0].push_back(static_cast<int>(cpu));
+        }
+    }
+    return topology;
+}
+
+int CpuTopology::nodeOf(int cpu) const {
+    for (size_t node = 0; node < nodes.size(); ++node) {
+        if (std::find(nodes[node].begin(), nodes[node].end(), cpu) != nodes[node].end()) {
+            return static_cast<int>(node);
+        }
+    }
+    return 0;
+}
+
+std::vector<WorkerPlacement> CpuTopology::plan(const AffinitySpec& spec, std::size_t workers) const {
+    std::vector<WorkerPlacement> placements(workers);
+    std::vector<int> order;
+
+    switch (spec.policy) {
+        case AffinitySpec::Policy::None:
+            return placements;
+        case AffinitySpec::Policy::List:
+            order = spec.cpus;
+            break;
+        case AffinitySpec::Policy::Compact:
+            for (const auto& node : nodes) {
+                order.insert(order.end(), node.begin(), node.end());
+            }
+            break;
+        case AffinitySpec::Policy::Scatter: {
+            size_t longest = 0;
+            for (const auto& node : nodes) {
+                longest = std::max(longest, node.size());
+            }
+            for (size_t i = 0; i < longest; ++i) {
+                for (const auto& node : nodes) {
+                    if (i < node.size()) {
+                        order.push_back(node[i]);
+                    }
+                }
+            }
+            break;
+        }
+    }
+
+    // More workers than CPUs wrap around, sharing CPUs in the same order
+    for (size_t i = 0; i < workers && !order.empty(); ++i) {
+        placements[i].cpu = order[i % order.size()];
+        placements[i].node = nodeOf(placements[i].cpu);
+    }
+    return placements;
+}
+
+bool pinCurrentThread(int cpu) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Placement of pool workers on CPUs, selected with the simulator's affinity= argument:
+//   none              let the OS schedule workers freely (default)
+//   compact           fill the CPUs of one NUMA node before moving on to the next
+//   scatter           spread workers round-robin over the NUMA nodes
+//   <cpu list>        pin workers to the listed CPUs in order, e.g. 0-7,16-23
+// Pinned workers keep a game's board, tanks and algorithm state in one cache hierarchy, and
+// since Linux places a page on the node of the thread that first touches it, each game's
+// memory (allocated by the worker running it, from glibc's per-thread arena) stays node-local.
+struct WorkerPlacement {
+    int cpu = -1;   // -1 leaves the worker unpinned
+    int node = 0;   // NUMA node of the cpu, used to keep nested tasks on the node
+};
+
+struct AffinitySpec {
+    enum class Policy { None, Compact, Scatter, List };
+    Policy policy = Policy::None;
+    std::vector<int> cpus;  // Only for Policy::List
+
+    // Returns false if the value is not a policy name or a valid CPU list
+    static bool parse(const std::string& value, AffinitySpec& spec);
+};
+
+struct CpuTopology {
+    std::vector<std::vector<int>> nodes;  // Online CPUs of every NUMA node
+
+    // Read from /sys; falls back to a single node with all hardware threads
+    static CpuTopology detect();
+
+    int nodeOf(int cpu) const;
+
+    // Placement for each of `workers` pool workers
+    std::vector<WorkerPlacement> plan(const AffinitySpec& spec, std::size_t workers) const;
+};
+
+// Pin the calling thread to one CPU; returns false if the OS refused
+bool pinCurrentThread(int cpu);
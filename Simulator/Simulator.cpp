@@ -8,6 +8,7 @@
 #include "../common/TankAlgorithmRegistration.h"
 #include "../UserCommon/GameSatelliteView.h"
 #include "../UserCommon/BoardConstants.h"
+#include "../UserCommon/TaskScheduler.h"
 #include "loader.h"
 #include "registrars.h"
 #include "threadpool.h"
@@ -28,13 +29,93 @@
 #include <string>
 #include <cstddef>
 #include <thread>
+#include <atomic>
+#include <cstdlib>
 
 using namespace UserCommon_208000547_208000547;
 
 namespace fs = std::filesystem;
 
+namespace {
+    // Exposes the running pool to the games, which submit nested work through run_nested()
+    class PoolScheduler : public TaskScheduler {
+    private:
+        ThreadPool& pool;
+    public:
+        explicit PoolScheduler(ThreadPool& pool) : pool(pool) {}
+        void runAll(std::size_t count, const std::function<void(std::size_t)>& task) override {
+            pool.run_nested(count, task);
+        }
+        std::size_t concurrency() const override { return pool.size(); }
+    };
+
+    std::atomic<TaskScheduler*> activeScheduler{nullptr};
+
+    thread_local bool referenceGameRunning = false;
+
+    // Marks the games run on this thread as determinism references for as long as it lives
+    class ReferenceGameScope {
+    public:
+        ReferenceGameScope() { referenceGameRunning = true; }
+        ~ReferenceGameScope() { referenceGameRunning = false; }
+    };
+
+    // Whether our GameManager hands the tank decisions of a game between these algorithms to the
+    // pool: it does for algorithms it is told are thread-safe (TANKGAME_THREADSAFE_ALGORITHMS, see
+    // its EngineOptions). Only such nested work can use more workers than there are games.
+    bool decisionsNest(const std::string& name1, const std::string& name2) {
+        const char* threadSafe = std::getenv("TANKGAME_THREADSAFE_ALGORITHMS");
+        if (!threadSafe) {
+            return false;
+        }
+        std::vector<std::string> names;
+        std::istringstream list(threadSafe);
+        std::string name;
+        while (std::getline(list, name, ',')) {
+            names.push_back(name);
+        }
+        return std::find(names.begin(), names.end(), name1) != names.end() &&
+               std::find(names.begin(), names.end(), name2) != names.end();
+    }
+
+    // The cells of a game's final state, row by row
+    std::string describeGameState(const SatelliteView& state, size_t width, size_t height) {
+        std::ostringstream stateStream;
+        for (size_t y = 0; y < height; ++y) {
+            for (size_t x = 0; x < width; ++x) {
+                stateStream << state.getObjectAt(x, y);
+            }
+            if (y < height - 1) {
+                stateStream << '\n';
+            }
+        }
+        return stateStream.str();
+    }
+
+    // Publishes a pool's scheduler for as long as the games on it run
+    class SchedulerScope {
+    private:
+        PoolScheduler scheduler;
+    public:
+        explicit SchedulerScope(ThreadPool& pool) : scheduler(pool) { activeScheduler.store(&scheduler); }
+        ~SchedulerScope() { activeScheduler.store(nullptr); }
+    };
+}
+
+namespace UserCommon_208000547_208000547 {
+    TaskScheduler* sharedTaskScheduler() {
+        return activeScheduler.load();
+    }
+
+    bool isReferenceGame() {
+        return referenceGameRunning;
+    }
+}
+
 Simulator::Simulator() {
     // Constructor - initialize any necessary state
+    const char* check = std::getenv("TANKGAME_CHECK_DETERMINISM");
+    checkDeterminism = check && std::string(check) == "1";
 }
 
 Simulator::~Simulator() {
@@ -54,6 +135,7 @@ void Simulator::cleanup(bool isPostExecution) {
     if (!isPostExecution) {
         gameResults.clear();
         algorithmScores.clear();
+        totalGameTime = std::chrono::milliseconds(0);
     }
     
     std::cout << (isPostExecution ? "Post-execution" : "Pre-execution") << " cleanup completed." << std::endl;
@@ -160,6 +242,14 @@ void Simulator::runSingleGame(const GameManagerRegistrar::Entry& gameManagerEntr
         auto endTime = std::chrono::high_resolution_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
         std::cout << "[LOG] Game execution completed in " << duration.count() << "ms" << std::endl;
+        {
+            std::lock_guard<std::mutex> lock(resultsMutex);
+            totalGameTime += duration;
+        }
+
+        if (checkDeterminism) {
+            checkAgainstSequentialGame(gameManagerEntry, algorithm1Entry, algorithm2Entry, mapFilename, gameMap, res);
+        }
         
         std::cout << "[LOG] Step 4: Processing game results..." << std::endl;
         // 4. Process and store the game results
@@ -196,16 +286,7 @@ void Simulator::runSingleGame(const GameManagerRegistrar::Entry& gameManagerEntr
         std::cout << "[LOG] Processing final game state..." << std::endl;
         // Convert final game state to string representation
         if (res.gameState) {
-            std::ostringstream stateStream;
-            for (size_t y = 0; y < H; ++y) {
-                for (size_t x = 0; x < W; ++x) {
-                    stateStream << res.gameState->getObjectAt(x, y);
-                }
-                if (y < H - 1) {
-                    stateStream << '\n';
-                }
-            }
-            result.finalGameState = stateStream.str();
+            result.finalGameState = describeGameState(*res.gameState, W, H);
             std::cout << "[LOG] Final game state captured successfully" << std::endl;
         } else {
             // Fallback to original map if no final state
@@ -248,6 +329,80 @@ void Simulator::runSingleGame(const GameManagerRegistrar::Entry& gameManagerEntr
     std::cout << "[LOG] Single game execution finished" << std::endl;
 }
 
+void Simulator::checkAgainstSequentialGame(const GameManagerRegistrar::Entry& gameManagerEntry,
+                                           const AlgorithmRegistrar::AlgorithmAndPlayerFactories& algorithm1Entry,
+                                           const AlgorithmRegistrar::AlgorithmAndPlayerFactories& algorithm2Entry,
+                                           const std::string& mapFilename,
+                                           const BoardData& gameMap,
+                                           const GameResult& checked) {
+    // Players and tank algorithms keep state across a game, so the reference gets fresh ones
+    try {
+        ReferenceGameScope reference;
+        const size_t W = gameMap.columns, H = gameMap.rows, MAX_STEPS = gameMap.maxStep, NUM_SHELLS = gameMap.numShells;
+        std::unique_ptr<AbstractGameManager> gm = gameManagerEntry.factory(false);
+        auto p1 = algorithm1Entry.createPlayer(1, W, H, MAX_STEPS, NUM_SHELLS);
+        auto p2 = algorithm2Entry.createPlayer(2, W, H, MAX_STEPS, NUM_SHELLS);
+        GameSatelliteView map(gameMap.board, W, H, W + 1, H + 1);
+        GameResult res = gm->run(
+            W, H,
+            map, mapFilename,
+            MAX_STEPS, NUM_SHELLS,
+            *p1, algorithm1Entry.name(), *p2, algorithm2Entry.name(),
+            algorithm1Entry.tankFactory(), algorithm2Entry.tankFactory()
+        );
+
+        bool same = res.winner == checked.winner && res.reason == checked.reason && res.rounds == checked.rounds &&
+                    res.remaining_tanks == checked.remaining_tanks &&
+                    (res.gameState == nullptr) == (checked.gameState == nullptr) &&
+                    (!res.gameState || describeGameState(*res.gameState, W, H) == describeGameState(*checked.gameState, W, H));
+        if (same) {
+            std::cout << "[LOG] Determinism check passed" << std::endl;
+        } else {
+            std::cerr << "[ERROR] Determinism check failed for " << gameManagerEntry.so_name << ": "
+                      << algorithm1Entry.name() << " vs " << algorithm2Entry.name() << " on " << mapFilename
+                      << " ended differently when played sequentially; parallel decisions changed the game" << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "[ERROR] Sequential reference game failed, skipping determinism check: " << e.what() << std::endl;
+    }
+}
+
+std::unique_ptr<ThreadPool> Simulator::createWorkerPool(size_t numThreads) {
+    if (workerAffinity.policy == AffinitySpec::Policy::None) {
+        return std::make_unique<ThreadPool>(numThreads);
+    }
+
+    CpuTopology topology = CpuTopology::detect();
+    std::vector<WorkerPlacement> placements = topology.plan(workerAffinity, numThreads);
+    std::vector<int> nodes;
+    std::cout << "[LOG] Pinning " << numThreads << " workers over " << topology.nodes.size() << " NUMA node(s):";
+    for (const auto& placement : placements) {
+        nodes.push_back(placement.node);
+        std::cout << " " << placement.cpu << "@" << placement.node;
+    }
+    std::cout << std::endl;
+
+    // Each worker pins itself before taking its first game, so everything it allocates is node-local
+    return std::make_unique<ThreadPool>(numThreads, [placements](size_t worker) {
+        if (!pinCurrentThread(placements[worker].cpu)) {
+            std::cerr << "[WARNING] Could not pin worker " << worker << " to CPU " << placements[worker].cpu << std::endl;
+        }
+    }, nodes);
+}
+
+void Simulator::reportMakespan(std::chrono::steady_clock::time_point start, size_t numGames, size_t numThreads) {
+    auto makespan = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    std::lock_guard<std::mutex> lock(resultsMutex);
+    std::cout << "[LOG] Makespan: " << makespan.count() << "ms for " << numGames << " games on "
+              << numThreads << " threads (total game time " << totalGameTime.count() << "ms";
+    if (makespan.count() > 0) {
+        std::cout << ", speedup " << std::fixed << std::setprecision(2)
+                  << static_cast<double>(totalGameTime.count()) / static_cast<double>(makespan.count())
+                  << std::defaultfloat;
+    }
+    std::cout << ")" << std::endl;
+}
+
 void Simulator::workerThreadFunction() {
     // This would be implemented to process game tasks from a queue
     // For now, it's a placeholder
@@ -369,21 +524,31 @@ bool Simulator::runComparativeMode(const std::string& gameMapFilename,
         );
     };
     
-    if (numThreads > 2 && numGameManagers > 1) {
-        // Use multi-threading for better performance
-        size_t actualThreads = std::min(static_cast<size_t>(numThreads), numGameManagers);
+    auto startTime = std::chrono::steady_clock::now();
+    // No more workers than games, which would sit idle, unless the games nest work onto the pool
+    size_t actualThreads = 1;
+    if (numThreads > 1) {
+        actualThreads = static_cast<size_t>(numThreads);
+        if (!decisionsNest(algo1Entry.name(), algo2Entry.name())) {
+            actualThreads = std::min(actualThreads, numGameManagers);
+        }
+    }
+    if (actualThreads > 1) {
         std::cout << "Using " << actualThreads << " threads for parallel execution" << std::endl;
         
         // Create thread pool
-        ThreadPool pool(actualThreads);
+        std::unique_ptr<ThreadPool> workers = createWorkerPool(actualThreads);
+        ThreadPool& pool = *workers;
+        SchedulerScope scheduler(pool);
         
         // Submit all games to the thread pool
         for (const auto& gmEntry : GameManagerRegistrar::get().entries()) {
             const std::string& gameManagerName = gmEntry.so_name;
             std::cout << "Submitting game with GameManager: " << gameManagerName << " to thread pool" << std::endl;
             
-            // Submit the game to run in a separate thread
-            pool.submit([runGame, gmEntry, gameManagerName]() {
+            // Submit the game to run in a separate thread. The entry and runGame outlive the pool's
+            // jobs (we wait for it below), so they are captured by reference rather than copied.
+            pool.submit([&runGame, &gmEntry, &gameManagerName]() {
                 std::cout << "Running game with GameManager: " << gameManagerName << " in thread " 
                           << std::this_thread::get_id() << std::endl;
                 
@@ -406,6 +571,8 @@ bool Simulator::runComparativeMode(const std::string& gameMapFilename,
         }
     }
     
+    reportMakespan(startTime, numGameManagers, actualThreads);
+
     // Write results
     writeComparativeOutput(gameManagersFolder, gameMapFilename, algorithm1Filename, algorithm2Filename);
     
@@ -568,17 +735,30 @@ void Simulator::runCompetitionGames(const std::vector<BoardData>& gameMaps,
         );
     };
     
-    if (numThreads > 2 && allGames.size() > 1) {
-        // Use multi-threading for better performance
-        size_t actualThreads = std::min(static_cast<size_t>(numThreads), allGames.size());
+    auto startTime = std::chrono::steady_clock::now();
+    // No more workers than games, which would sit idle, unless the games nest work onto the pool
+    size_t actualThreads = 1;
+    if (numThreads > 1) {
+        actualThreads = static_cast<size_t>(numThreads);
+        bool nested = std::any_of(allGames.begin(), allGames.end(), [](const GameTask& task) {
+            return decisionsNest(task.algo1.name(), task.algo2.name());
+        });
+        if (!nested) {
+            actualThreads = std::min(actualThreads, allGames.size());
+        }
+    }
+    if (actualThreads > 1) {
         std::cout << "Using " << actualThreads << " threads for parallel execution" << std::endl;
         
         // Create thread pool
-        ThreadPool pool(actualThreads);
+        std::unique_ptr<ThreadPool> workers = createWorkerPool(actualThreads);
+        ThreadPool& pool = *workers;
+        SchedulerScope scheduler(pool);
         
         // Submit all games to the thread pool
         for (const auto& game : allGames) {
-            pool.submit([runGame, game]() {
+            // allGames outlives the pool's jobs, so each job refers to its task instead of copying it
+            pool.submit([&runGame, &game]() {
                 runGame(game);
             });
         }
@@ -598,6 +778,8 @@ void Simulator::runCompetitionGames(const std::vector<BoardData>& gameMaps,
             runGame(game);
         }
     }
+
+    reportMakespan(startTime, allGames.size(), actualThreads);
 }
 
 void Simulator::writeComparativeOutput(const std::string& gameManagersFolder,
@@ -8,10 +8,12 @@
 #include <condition_variable>
 #include <unordered_map>
 #include <functional>
+#include <chrono>
 #include <dlfcn.h>
 #include "../UserCommon/BoardReader.h"
 #include "loader.h"
 #include "registrars.h"
+#include "CpuTopology.h"
 
 using namespace UserCommon_208000547_208000547;
 
@@ -19,6 +21,8 @@ using namespace UserCommon_208000547_208000547;
 class AbstractGameManager;
 class Player;
 class TankAlgorithm;
+class ThreadPool;
+struct GameResult;
 
 // Type aliases for dynamic loading
 using GameManagerFactory = std::function<std::unique_ptr<AbstractGameManager>(bool verbose)>;
@@ -75,10 +79,15 @@ private:
     // Results storage
     std::vector<GameRunResult> gameResults;
     std::unordered_map<std::string, AlgorithmScore> algorithmScores;
+    std::chrono::milliseconds totalGameTime{0};  // Sum of all games' run times, for the makespan report
+    AffinitySpec workerAffinity;  // Where pool workers are pinned
+    bool checkDeterminism;  // TANKGAME_CHECK_DETERMINISM=1: play every game again sequentially and compare
     
     std::string generateTimestamp();
     std::string extractLibraryName(const std::string& filepath);
     std::string formatGameResultMessage(int winner, const std::string& reason, size_t rounds);
+    std::unique_ptr<ThreadPool> createWorkerPool(size_t numThreads);
+    void reportMakespan(std::chrono::steady_clock::time_point start, size_t numGames, size_t numThreads);
     void logSOStatus(const std::string& soName, bool started, const std::string& algorithm1Name = "", const std::string& algorithm2Name = "");
 
     void runSingleGame(const GameManagerRegistrar::Entry& gameManagerEntry, 
@@ -87,6 +96,14 @@ private:
                       const std::string& mapFilename,
                       const BoardData& gameMap,
                       bool verbose);
+    // Play the game again with fresh players, deciding one tank at a time, and report whether it
+    // ended like `checked`
+    void checkAgainstSequentialGame(const GameManagerRegistrar::Entry& gameManagerEntry,
+                                    const AlgorithmRegistrar::AlgorithmAndPlayerFactories& algorithm1Entry,
+                                    const AlgorithmRegistrar::AlgorithmAndPlayerFactories& algorithm2Entry,
+                                    const std::string& mapFilename,
+                                    const BoardData& gameMap,
+                                    const GameResult& checked);
     
     // Competition game running logic
     void runCompetitionGames(const std::vector<BoardData>& gameMaps,
@@ -130,6 +147,9 @@ public:
                            int numThreads = 1,
                            bool verbose = false);
     
+    // Pin pool workers to CPUs (see CpuTopology.h); applies to pools created afterwards
+    void setWorkerAffinity(const AffinitySpec& affinity) { workerAffinity = affinity; }
+
     // Public cleanup method for external use
     void performCleanup(bool isPostExecution = false);
     
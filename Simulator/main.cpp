@@ -1,5 +1,6 @@
 #include "Simulator.h"
 #include "CommandLineArgs.h"
+#include "CpuTopology.h"
 #include <iostream>
 #include <string>
 #include <vector>
@@ -16,28 +17,29 @@ void printUsage(const std::string& programName, const CommandLineArgs& args) {
                   << "game_managers_folder=<game_managers_folder> "
                   << "algorithm1=<algorithm_so_filename> "
                   << "algorithm2=<algorithm_so_filename> "
-                  << "[num_threads=<num>] [-verbose]" << std::endl;
+                  << "[num_threads=<num>] [affinity=<policy>] [-verbose]" << std::endl;
     } else if (args.competition) {
         std::cout << "  " << programName << " -competition game_maps_folder=<game_maps_folder> "
                   << "game_manager=<game_manager_so_filename> "
                   << "algorithms_folder=<algorithms_folder> "
-                  << "[num_threads=<num>] [-verbose]" << std::endl;
+                  << "[num_threads=<num>] [affinity=<policy>] [-verbose]" << std::endl;
     } else {
         std::cout << "  " << programName << " -comparative game_map=<game_map_filename> "
                   << "game_managers_folder=<game_managers_folder> "
                   << "algorithm1=<algorithm_so_filename> "
                   << "algorithm2=<algorithm_so_filename> "
-                  << "[num_threads=<num>] [-verbose]" << std::endl;
+                  << "[num_threads=<num>] [affinity=<policy>] [-verbose]" << std::endl;
         std::cout << "  " << programName << " -competition game_maps_folder=<game_maps_folder> "
                   << "game_manager=<game_manager_so_filename> "
                   << "algorithms_folder=<algorithms_folder> "
-                  << "[num_threads=<num>] [-verbose]" << std::endl;
+                  << "[num_threads=<num>] [affinity=<policy>] [-verbose]" << std::endl;
     }
     
     std::cout << std::endl;
     std::cout << "Note: All arguments can appear in any order." << std::endl;
     std::cout << "      The = sign can appear with any number of spaces around." << std::endl;
     std::cout << "      num_threads is optional (default: 1)." << std::endl;
+    std::cout << "      affinity is optional (default: none): none, compact, scatter or a CPU list like 0-7,16-23." << std::endl;
 }
 
 void printErrors(const CommandLineArgs& args) {
@@ -92,6 +94,12 @@ CommandLineArgs parseCommandLine(int argc, char* argv[]) {
             } catch (const std::exception&) {
                 args.numThreads = 1;
             }
+        } else if (arg.find("affinity=") == 0) {
+            args.affinity = arg.substr(9); // Remove "affinity=" prefix
+            AffinitySpec spec;
+            if (!AffinitySpec::parse(args.affinity, spec)) {
+                args.unsupportedArgs.push_back(arg);
+            }
         } else {
             args.unsupportedArgs.push_back(arg);
         }
@@ -221,6 +229,9 @@ int main(int argc, char* argv[]) {
     try {
         // Create simulator instance
         Simulator simulator;
+        AffinitySpec affinity;
+        AffinitySpec::parse(args.affinity, affinity);
+        simulator.setWorkerAffinity(affinity);
         
         bool success = false;
         
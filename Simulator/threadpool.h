@@ -1,25 +1,45 @@
 #pragma once
 #include <condition_variable>
+#include <deque>
+#include <exception>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
 #include <vector>
 
+// Pool running two levels of work:
+//  - jobs, submitted with submit() (whole games), run in FIFO order;
+//  - nested tasks, spawned by a running job with run_nested() (e.g. per-tank decisions).
+// Workers always prefer nested tasks, so once the job queue drains the idle workers help
+// the games still running finish instead of sleeping through the tail of the tournament.
+// A job waiting in run_nested() runs nested tasks itself, so nesting can never deadlock.
+// Workers can be given a start hook (e.g. to pin them to a CPU) and a NUMA node each; nested
+// tasks are then preferably run by workers on the node of the job that spawned them.
 class ThreadPool {
 public:
-    explicit ThreadPool(std::size_t workers)
+    explicit ThreadPool(std::size_t workers,
+                        std::function<void(std::size_t)> on_start = nullptr,
+                        std::vector<int> worker_nodes = {})
         : stop_(false), active_(0) {
+        worker_nodes.resize(workers, 0);
         for (std::size_t i = 0; i < workers; ++i) {
-            threads_.emplace_back([this] {
+            threads_.emplace_back([this, i, on_start, node = worker_nodes[i]] {
+                if (on_start) on_start(i);
+                current_node() = node;
                 for (;;) {
                     std::function<void()> job;
                     {
                         std::unique_lock<std::mutex> lk(m_);
-                        cv_jobs_.wait(lk, [this] { return stop_ || !jobs_.empty(); });
-                        if (stop_ && jobs_.empty()) return;
-                        job = std::move(jobs_.front());
-                        jobs_.pop();
+                        cv_jobs_.wait(lk, [this] { return stop_ || !nested_.empty() || !jobs_.empty(); });
+                        if (stop_ && nested_.empty() && jobs_.empty()) return;
+                        if (!nested_.empty()) {
+                            job = take_nested(node);
+                        } else {
+                            job = std::move(jobs_.front());
+                            jobs_.pop();
+                        }
                         ++active_;
                     }
                     try { job(); }
@@ -27,7 +47,7 @@ public:
                     {
                         std::lock_guard<std::mutex> lk(m_);
                         --active_;
-                        if (jobs_.empty() && active_ == 0) cv_idle_.notify_all();
+                        if (jobs_.empty() && nested_.empty() && active_ == 0) cv_idle_.notify_all();
                     }
                 }
             });
@@ -36,6 +56,8 @@ public:
 
     ~ThreadPool() { shutdown(); }
 
+    std::size_t size() const { return threads_.size(); }
+
     template<class F>
     void submit(F&& f) {
         {
@@ -46,9 +68,46 @@ public:
         cv_jobs_.notify_one();
     }
 
+    // Run task(i) for every i in [0, count) on the pool and return once all have finished.
+    // Meant to be called from inside a job; the caller helps with nested tasks while it waits.
+    // The first exception thrown by a task is rethrown here.
+    void run_nested(std::size_t count, const std::function<void(std::size_t)>& task) {
+        if (count == 0) return;
+        auto batch = std::make_shared<Batch>();
+        batch->remaining = count;
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            for (std::size_t i = 0; i < count; ++i) {
+                int node = current_node();
+                nested_.push_back({node, [this, batch, &task, i] {
+                    std::exception_ptr error;
+                    try { task(i); }
+                    catch (...) { error = std::current_exception(); }
+                    std::lock_guard<std::mutex> lk(m_);
+                    if (error && !batch->error) batch->error = error;
+                    if (--batch->remaining == 0) cv_jobs_.notify_all();
+                }});
+            }
+        }
+        cv_jobs_.notify_all();
+
+        std::unique_lock<std::mutex> lk(m_);
+        while (batch->remaining > 0) {
+            if (nested_.empty()) {
+                cv_jobs_.wait(lk, [&] { return batch->remaining == 0 || !nested_.empty(); });
+                continue;
+            }
+            std::function<void()> job = take_nested(current_node());
+            lk.unlock();
+            job();
+            lk.lock();
+        }
+        if (batch->error) std::rethrow_exception(batch->error);
+    }
+
     void wait_idle() {
         std::unique_lock<std::mutex> lk(m_);
-        cv_idle_.wait(lk, [this] { return jobs_.empty() && active_ == 0; });
+        cv_idle_.wait(lk, [this] { return jobs_.empty() && nested_.empty() && active_ == 0; });
     }
 
     void shutdown() {
@@ -63,11 +122,39 @@ public:
     }
 
 private:
+    struct Batch {
+        std::size_t remaining = 0;
+        std::exception_ptr error;
+    };
+
+    struct NestedTask {
+        int node;
+        std::function<void()> run;
+    };
+
+    // NUMA node of the calling thread, 0 outside the pool
+    static int& current_node() {
+        thread_local int node = 0;
+        return node;
+    }
+
+    // Oldest nested task spawned on `node`, or the oldest one overall. Call with m_ held.
+    std::function<void()> take_nested(int node) {
+        auto it = nested_.begin();
+        for (auto scan = nested_.begin(); scan != nested_.end(); ++scan) {
+            if (scan->node == node) { it = scan; break; }
+        }
+        std::function<void()> job = std::move(it->run);
+        nested_.erase(it);
+        return job;
+    }
+
     std::vector<std::thread> threads_;
     std::queue<std::function<void()>> jobs_;
+    std::deque<NestedTask> nested_;
     std::mutex m_;
     std::condition_variable cv_jobs_;
     std::condition_variable cv_idle_;
     bool stop_;
     std::size_t active_;
-};
\ No newline at end of file
+};
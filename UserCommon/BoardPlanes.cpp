@@ -0,0 +1,159 @@
+#include "BoardPlanes.h"
+#include "BoardConstants.h"
+
+namespace UserCommon_208000547_208000547 {
+
+BoardPlanes::PlaneMask BoardPlanes::planesOf(char cell) {
+    switch (cell) {
+        case WALL: return bit(Wall);
+        case DAMAGED_WALL: return bit(DamagedWall);
+        case MINE: return bit(Mine);
+        case PLAYER1_TANK: return bit(Tank1);
+        case PLAYER2_TANK: return bit(Tank2);
+        case SHELL: return bit(Shell);
+        case MINE_SHELL_COLLISION: return bit(Mine) | bit(Shell);  // A shell flying over a mine
+        default: return 0;
+    }
+}
+
+void BoardPlanes::reset(size_t newRows, size_t newColumns) {
+    rows = newRows;
+    columns = newColumns;
+    wordsPerRow = (columns + 63) / 64;
+    bits.assign(PlaneCount * rows * wordsPerRow, 0);
+}
+
+void BoardPlanes::setCell(size_t x, size_t y, char cell) {
+    const PlaneMask planes = planesOf(cell);
+    const uint64_t mask = uint64_t{1} << (x % 64);
+    for (int p = 0; p < PlaneCount; ++p) {
+        uint64_t& word = bits[wordIndex(static_cast<Plane>(p), y, x / 64)];
+        if (planes & (1u << p)) {
+            word |= mask;
+        } else {
+            word &= ~mask;
+        }
+    }
+}
+
+uint64_t BoardPlanes::rowWord(PlaneMask planes, size_t y, size_t word) const {
+    uint64_t result = 0;
+    for (int p = 0; p < PlaneCount; ++p) {
+        if (planes & (1u << p)) {
+            result |= bits[wordIndex(static_cast<Plane>(p), y, word)];
+        }
+    }
+    return result;
+}
+
+bool BoardPlanes::test(PlaneMask planes, size_t x, size_t y) const {
+    return (rowWord(planes, y, x / 64) >> (x % 64)) & 1u;
+}
+
+size_t BoardPlanes::count(Plane plane) const {
+    size_t total = 0;
+    const size_t begin = wordIndex(plane, 0, 0);
+    for (size_t i = begin; i < begin + rows * wordsPerRow; ++i) {
+        total += static_cast<size_t>(__builtin_popcountll(bits[i]));
+    }
+    return total;
+}
+
+uint8_t BoardPlanes::neighbours(PlaneMask planes, size_t x, size_t y) const {
+    uint8_t result = 0;
+    for (int d = 0; d < 8; ++d) {
+        const Direction dir = Direction::fromIndex(d);
+        const size_t nx = (x + columns + dir.dx()) % columns;
+        const size_t ny = (y + rows + dir.dy()) % rows;
+        if (test(planes, nx, ny)) {
+            result |= static_cast<uint8_t>(1u << d);
+        }
+    }
+    return result;
+}
+
+size_t BoardPlanes::firstInRow(PlaneMask planes, size_t y, size_t from, size_t to) const {
+    for (size_t word = from / 64; word <= to / 64; ++word) {
+        uint64_t bitsInRange = rowWord(planes, y, word);
+        if (word == from / 64) {
+            bitsInRange &= ~uint64_t{0} << (from % 64);
+        }
+        if (word == to / 64 && to % 64 != 63) {
+            bitsInRange &= (uint64_t{1} << (to % 64 + 1)) - 1;
+        }
+        if (bitsInRange) {
+            return word * 64 + static_cast<size_t>(__builtin_ctzll(bitsInRange));
+        }
+    }
+    return columns;
+}
+
+size_t BoardPlanes::lastInRow(PlaneMask planes, size_t y, size_t from, size_t to) const {
+    for (size_t word = to / 64 + 1; word-- > from / 64;) {
+        uint64_t bitsInRange = rowWord(planes, y, word);
+        if (word == from / 64) {
+            bitsInRange &= ~uint64_t{0} << (from % 64);
+        }
+        if (word == to / 64 && to % 64 != 63) {
+            bitsInRange &= (uint64_t{1} << (to % 64 + 1)) - 1;
+        }
+        if (bitsInRange) {
+            return word * 64 + 63 - static_cast<size_t>(__builtin_clzll(bitsInRange));
+        }
+    }
+    return columns;
+}
+
+size_t BoardPlanes::firstHit(PlaneMask planes, size_t x, size_t y, Direction dir, size_t maxSteps) const {
+    if (dir.dy() == 0) {
+        // Row ray: at most two word-parallel range scans, before and after wrapping around
+        const size_t steps = maxSteps < columns ? maxSteps : columns;
+        if (steps == 0) {
+            return 0;
+        }
+        if (dir.dx() > 0) {
+            const size_t beforeWrap = columns - 1 - x;
+            if (beforeWrap > 0) {
+                const size_t hit = firstInRow(planes, y, x + 1, x + (steps < beforeWrap ? steps : beforeWrap));
+                if (hit != columns) {
+                    return hit - x;
+                }
+            }
+            if (steps > beforeWrap) {
+                const size_t hit = firstInRow(planes, y, 0, steps - beforeWrap - 1);
+                if (hit != columns) {
+                    return beforeWrap + 1 + hit;
+                }
+            }
+        } else {
+            const size_t beforeWrap = x;
+            if (beforeWrap > 0) {
+                const size_t hit = lastInRow(planes, y, x - (steps < beforeWrap ? steps : beforeWrap), x - 1);
+                if (hit != columns) {
+                    return x - hit;
+                }
+            }
+            if (steps > beforeWrap) {
+                const size_t hit = lastInRow(planes, y, columns - (steps - beforeWrap), columns - 1);
+                if (hit != columns) {
+                    return beforeWrap + columns - hit;
+                }
+            }
+        }
+        return 0;
+    }
+
+    // Column or diagonal ray: one bit test per row
+    size_t cx = x;
+    size_t cy = y;
+    for (size_t step = 1; step <= maxSteps; ++step) {
+        cx = (cx + columns + dir.dx()) % columns;
+        cy = (cy + rows + dir.dy()) % rows;
+        if (test(planes, cx, cy)) {
+            return step;
+        }
+    }
+    return 0;
+}
+
+} // namespace UserCommon_208000547_208000547
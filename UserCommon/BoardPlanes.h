@@ -0,0 +1,92 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+#include "Direction.h"
+
+namespace UserCommon_208000547_208000547 {
+
+// Bit-packed companion of a char board: one bit plane per class of object, each row padded to
+// whole 64-bit words. Occupancy questions ("is the next cell a wall", "is the line of fire
+// clear", "how many tanks are left") become a few word operations instead of char compares.
+// The owner of the char board keeps the planes in sync by passing every cell it writes to
+// setCell(), or by calling rebuild() after replacing the board.
+class BoardPlanes {
+public:
+    enum Plane : uint8_t { Wall, DamagedWall, Mine, Tank1, Tank2, Shell, PlaneCount };
+
+    // Sets of planes, bit p for plane p
+    using PlaneMask = uint8_t;
+    static constexpr PlaneMask bit(Plane plane) { return static_cast<PlaneMask>(1u << plane); }
+    static constexpr PlaneMask BLOCKING = (1u << Wall) | (1u << DamagedWall);  // Stops tanks and shells
+    static constexpr PlaneMask TANKS = (1u << Tank1) | (1u << Tank2);
+
+    // Planes a board character belongs to (collision markers belong to none)
+    static PlaneMask planesOf(char cell);
+
+    explicit BoardPlanes(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : bits(resource) {}
+
+    // Rebuild all planes from a row-major char grid (any vector of rows of chars)
+    template <class Grid>
+    void rebuild(const Grid& grid, size_t rows, size_t columns) {
+        reset(rows, columns);
+        for (size_t y = 0; y < rows; ++y) {
+            for (size_t x = 0; x < columns; ++x) {
+                setCell(x, y, grid[y][x]);
+            }
+        }
+    }
+
+    void reset(size_t rows, size_t columns);  // Empty planes of the given size
+    void setCell(size_t x, size_t y, char cell);
+
+    size_t getRows() const { return rows; }
+    size_t getColumns() const { return columns; }
+
+    // Whether (x, y) is in any of `planes`
+    bool test(PlaneMask planes, size_t x, size_t y) const;
+
+    // Number of cells in a plane
+    size_t count(Plane plane) const;
+
+    // Call f(x, y) for every cell of a plane, row by row; empty words are skipped whole
+    template <class F>
+    void forEachCell(Plane plane, F&& f) const {
+        for (size_t y = 0; y < rows; ++y) {
+            for (size_t word = 0; word < wordsPerRow; ++word) {
+                for (uint64_t w = bits[wordIndex(plane, y, word)]; w != 0; w &= w - 1) {
+                    f(word * 64 + static_cast<size_t>(__builtin_ctzll(w)), y);
+                }
+            }
+        }
+    }
+
+    // The 8 neighbours of (x, y) (the board wraps around) that are in any of `planes`:
+    // bit d is set for the neighbour in Direction::fromIndex(d)
+    uint8_t neighbours(PlaneMask planes, size_t x, size_t y) const;
+
+    // Steps from (x, y) in direction `dir` to the first cell in any of `planes`, looking at most
+    // `maxSteps` cells ahead (step 0, the start cell itself, is never hit); 0 if there is none.
+    // Horizontal rays are scanned a word at a time; other rays take one bit test per row.
+    size_t firstHit(PlaneMask planes, size_t x, size_t y, Direction dir, size_t maxSteps) const;
+
+    bool isRayClear(PlaneMask planes, size_t x, size_t y, Direction dir, size_t steps) const {
+        return firstHit(planes, x, y, dir, steps) == 0;
+    }
+
+private:
+    size_t rows = 0;
+    size_t columns = 0;
+    size_t wordsPerRow = 0;
+    std::pmr::vector<uint64_t> bits;  // Plane-major, then row-major
+
+    size_t wordIndex(Plane plane, size_t y, size_t word) const { return (plane * rows + y) * wordsPerRow + word; }
+    uint64_t rowWord(PlaneMask planes, size_t y, size_t word) const;  // Union of the planes' word
+    // First (or last) cell in [from, to] of row y that is in any of `planes`; `columns` if none
+    size_t firstInRow(PlaneMask planes, size_t y, size_t from, size_t to) const;
+    size_t lastInRow(PlaneMask planes, size_t y, size_t from, size_t to) const;
+};
+
+} // namespace UserCommon_208000547_208000547
@@ -60,7 +60,7 @@ char BoardReader::validateAndProcessChar(char c, int line_number, size_t positio
 }
 
 void BoardReader::processBoardLine(const string& line, int line_number, BoardData& data) {
-    vector<char> row;
+    BoardRow row;
     for (size_t i = 0; i < data.columns; i++) {
         char c;
         if (i < line.length()) {
@@ -84,7 +84,7 @@ void BoardReader::processBoardLine(const string& line, int line_number, BoardDat
 void BoardReader::fillMissingRows(BoardData& data) {
     while (data.board.size() < data.rows) {
         logError("Warning: File has fewer rows than specified height. Adding empty rows.");
-        vector<char> emptyRow(data.columns, EMPTY_SPACE);
+        BoardRow emptyRow(data.columns, EMPTY_SPACE);
         data.board.push_back(emptyRow);
     }
 }
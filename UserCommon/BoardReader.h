@@ -4,16 +4,21 @@
 #include <fstream>
 #include <stdexcept>
 #include "BoardConstants.h"
+#include "GameArena.h"
 
 namespace UserCommon_208000547_208000547 {
 
 struct BoardData {
+    // The board's rows are allocated from `resource` (the default heap unless a game arena is given)
+    explicit BoardData(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : board(resource) {}
+
     std::string mapName;
     size_t maxStep;
     size_t numShells;
     size_t rows;
     size_t columns;
-    std::vector<std::vector<char>> board;
+    BoardGrid board;
     size_t player1TankCount;
     size_t player2TankCount;
 };
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+
+namespace UserCommon_208000547_208000547 {
+
+// One of the 8 directions a tank or shell can face, stored as a 3-bit index running clockwise
+// from right (x grows to the right, y grows downwards). Deltas, rotations and turn distances
+// are constexpr table lookups, so no code ever searches for a direction vector.
+class Direction {
+public:
+    enum Value : uint8_t { Right, DownRight, Down, DownLeft, Left, UpLeft, Up, UpRight };
+
+    constexpr Direction(Value value = Right) : index(value) {}
+
+    static constexpr Direction fromIndex(int i) { return Direction(static_cast<Value>(i & 7)); }
+
+    // Direction of the unit step (dx, dy); false if it is not one of the 8 directions
+    static constexpr bool fromDelta(int dx, int dy, Direction& out) {
+        if (dx < -1 || dx > 1 || dy < -1 || dy > 1 || (dx == 0 && dy == 0)) {
+            return false;
+        }
+        out = fromIndex(FROM_DELTA[dy + 1][dx + 1]);
+        return true;
+    }
+
+    constexpr int toIndex() const { return index; }
+    constexpr int dx() const { return DX[index]; }
+    constexpr int dy() const { return DY[index]; }
+
+    // Rotated by `steps` 45-degree steps, clockwise for positive steps
+    constexpr Direction rotated(int steps) const { return fromIndex(index + 8 + steps % 8); }
+    constexpr Direction rotate45(bool clockwise) const { return rotated(clockwise ? 1 : -1); }
+    constexpr Direction rotate90(bool clockwise) const { return rotated(clockwise ? 2 : -2); }
+    constexpr Direction opposite() const { return rotated(4); }
+
+    // Shortest turn to `to` in 45-degree steps: -3..3 (negative = counter-clockwise), or 4 for
+    // a half turn
+    constexpr int turnTo(Direction to) const { return TURN[index][to.index]; }
+
+    constexpr bool operator==(Direction other) const { return index == other.index; }
+    constexpr bool operator!=(Direction other) const { return index != other.index; }
+
+private:
+    static constexpr int8_t DX[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+    static constexpr int8_t DY[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+    static constexpr uint8_t FROM_DELTA[3][3] = {
+        {UpLeft, Up, UpRight},        // dy = -1
+        {Left, Right, Right},         // dy = 0 (the centre is never read)
+        {DownLeft, Down, DownRight},  // dy = 1
+    };
+    static constexpr int8_t TURN[8][8] = {
+        { 0,  1,  2,  3,  4, -3, -2, -1},
+        {-1,  0,  1,  2,  3,  4, -3, -2},
+        {-2, -1,  0,  1,  2,  3,  4, -3},
+        {-3, -2, -1,  0,  1,  2,  3,  4},
+        { 4, -3, -2, -1,  0,  1,  2,  3},
+        { 3,  4, -3, -2, -1,  0,  1,  2},
+        { 2,  3,  4, -3, -2, -1,  0,  1},
+        { 1,  2,  3,  4, -3, -2, -1,  0},
+    };
+
+    uint8_t index;
+};
+
+} // namespace UserCommon_208000547_208000547
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace UserCommon_208000547_208000547 {
+
+// Board storage. Rows take their allocator from the board, so a board built on an arena keeps
+// all of its rows there; copies made with the copy constructor use the default heap again.
+using BoardRow = std::pmr::vector<char>;
+using BoardGrid = std::pmr::vector<BoardRow>;
+
+// Memory for everything one game allocates on the engine side (board, tanks, shells and the
+// per-round bookkeeping). Memory is taken from large blocks and recycled within the game by a
+// pool, and every block is freed at once when the arena is destroyed at the end of the game.
+// Not thread-safe: only the thread running the game may allocate from it.
+class GameArena {
+public:
+    explicit GameArena(std::size_t initialBytes = 64 * 1024)
+        : block(initialBytes), pool(&block) {}
+
+    GameArena(const GameArena&) = delete;
+    GameArena& operator=(const GameArena&) = delete;
+
+    std::pmr::memory_resource* resource() { return &pool; }
+
+private:
+    std::pmr::monotonic_buffer_resource block;
+    std::pmr::unsynchronized_pool_resource pool;
+};
+
+} // namespace UserCommon_208000547_208000547
@@ -2,7 +2,7 @@
 
 namespace UserCommon_208000547_208000547 {
 
-GameSatelliteView::GameSatelliteView(const vector<vector<char>>& board, size_t rows, size_t columns,
+GameSatelliteView::GameSatelliteView(const BoardGrid& board, size_t rows, size_t columns,
                                    size_t requestingTankX, size_t requestingTankY)
     : board(board), rows(rows), columns(columns), 
       requestingTankX(requestingTankX), requestingTankY(requestingTankY) {}
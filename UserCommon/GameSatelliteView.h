@@ -3,6 +3,7 @@
 #include "../common/SatelliteView.h"
 #include <vector>
 #include "BoardConstants.h"
+#include "GameArena.h"
 
 using namespace std;
 
@@ -10,14 +11,14 @@ namespace UserCommon_208000547_208000547 {
 
 class GameSatelliteView : public SatelliteView {
 private:
-    const vector<vector<char>>& board;
+    const BoardGrid& board;
     const size_t rows;
     const size_t columns;
     const size_t requestingTankX;
     const size_t requestingTankY;
 
 public:
-    GameSatelliteView(const vector<vector<char>>& board, size_t rows, size_t columns, 
+    GameSatelliteView(const BoardGrid& board, size_t rows, size_t columns, 
                      size_t requestingTankX, size_t requestingTankY);
     virtual ~GameSatelliteView() override;
     virtual char getObjectAt(size_t x, size_t y) const override;
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+
+namespace UserCommon_208000547_208000547 {
+
+// Runs batches of independent indexed tasks in parallel.
+class TaskScheduler {
+public:
+    virtual ~TaskScheduler() {}
+
+    // Run task(i) for every i in [0, count) and return once all have finished.
+    // The first exception thrown by a task is rethrown here.
+    virtual void runAll(std::size_t count, const std::function<void(std::size_t)>& task) = 0;
+
+    // Number of threads that may work on a batch
+    virtual std::size_t concurrency() const = 0;
+};
+
+// The scheduler shared by all games of the running simulator, so that games can spawn nested
+// work onto the simulator's own pool. Null while no pool is running.
+// Defined by our simulator, which exports its symbols to the libraries it loads. The declaration
+// is weak so that libraries still load into simulators that don't provide it; check the function
+// itself for null before calling it.
+TaskScheduler* sharedTaskScheduler() __attribute__((weak));
+
+// True on a thread where the simulator replays a game to check that parallel tank decisions did
+// not change it (TANKGAME_CHECK_DETERMINISM). The game must then decide one tank at a time and
+// write no files. Weak like sharedTaskScheduler.
+bool isReferenceGame() __attribute__((weak));
+
+} // namespace UserCommon_208000547_208000547